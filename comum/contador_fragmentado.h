@@ -0,0 +1,103 @@
+#ifndef CONTADOR_FRAGMENTADO_H
+#define CONTADOR_FRAGMENTADO_H
+
+// Contador fragmentado (sharded): um fragmento por thread, cada um em sua própria linha de cache
+//
+// - Incremento: só a thread dona escreve no fragmento -> load + store relaxados, sem LOCK
+// - Leitura aproximada: soma relaxada dos fragmentos, pode ser feita a qualquer momento (os
+//   ponteiros dos fragmentos são publicados com store-release e lidos com load-acquire, porque
+//   cada thread aloca o próprio fragmento dentro da região paralela)
+// - Coleta exata: soma após as threads terminarem (barreira do fim da região paralela)
+//
+// Cada fragmento fica em uma página própria, tocada primeiro pela thread dona: com a política
+// first-touch do Linux, a página é alocada no nó NUMA onde essa thread está executando.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdatomic.h>
+
+#define CONTADOR_LINHA 128        // Duas linhas de 64 bytes: evita também o prefetch do par adjacente
+#define CONTADOR_PAGINA 4096
+
+typedef struct {
+    _Alignas(CONTADOR_LINHA) atomic_llong valor;
+    char preenchimento[CONTADOR_LINHA - sizeof(atomic_llong)];
+} FragmentoContador;
+
+typedef struct {
+    _Atomic(FragmentoContador *) *fragmentos;  // fragmentos[tid], cada um em página própria
+    int num_fragmentos;
+} ContadorFragmentado;
+
+// Cria o contador sem tocar nos fragmentos: cada thread deve chamar contador_preparar_local
+static inline void contador_criar(ContadorFragmentado *c, int num_fragmentos) {
+    c->num_fragmentos = num_fragmentos;
+    c->fragmentos = malloc(num_fragmentos * sizeof(_Atomic(FragmentoContador *)));
+    if (c->fragmentos == NULL) {
+        fprintf(stderr, "Erro ao alocar memória para o contador fragmentado\n");
+        exit(1);
+    }
+    for (int i = 0; i < num_fragmentos; i++) atomic_init(&c->fragmentos[i], NULL);
+}
+
+// Chamada pela thread dona (dentro da região paralela): aloca e toca o próprio fragmento
+static inline FragmentoContador *contador_preparar_local(ContadorFragmentado *c, int tid) {
+    FragmentoContador *f = atomic_load_explicit(&c->fragmentos[tid], memory_order_relaxed);  // Só a dona escreve
+    if (f == NULL) {
+        void *pagina = NULL;
+        if (posix_memalign(&pagina, CONTADOR_PAGINA, CONTADOR_PAGINA) != 0) {
+            fprintf(stderr, "Erro ao alocar fragmento do contador\n");
+            exit(1);
+        }
+        memset(pagina, 0, CONTADOR_PAGINA);  // First touch pela thread dona
+        f = pagina;
+        atomic_init(&f->valor, 0);
+        // Publica o fragmento já zerado: quem lê o ponteiro com acquire vê o valor inicial
+        atomic_store_explicit(&c->fragmentos[tid], f, memory_order_release);
+    }
+    return f;
+}
+
+// Incremento local: leitura e escrita relaxadas (só a dona escreve, então não há corrida
+// de atualização; leitores concorrentes veem o valor antigo ou o novo, nunca um valor rasgado)
+static inline void contador_somar(FragmentoContador *f, long long delta) {
+    long long atual = atomic_load_explicit(&f->valor, memory_order_relaxed);
+    atomic_store_explicit(&f->valor, atual + delta, memory_order_relaxed);
+}
+
+// Leitura barata durante a execução: pode estar levemente atrasada
+static inline long long contador_ler_aproximado(const ContadorFragmentado *c) {
+    long long total = 0;
+    for (int i = 0; i < c->num_fragmentos; i++) {
+        FragmentoContador *f = atomic_load_explicit(&c->fragmentos[i], memory_order_acquire);
+        if (f != NULL) total += atomic_load_explicit(&f->valor, memory_order_relaxed);
+    }
+    return total;
+}
+
+// Soma exata: chamar depois que todas as threads terminaram de incrementar
+static inline long long contador_coletar(const ContadorFragmentado *c) {
+    long long total = 0;
+    for (int i = 0; i < c->num_fragmentos; i++) {
+        FragmentoContador *f = atomic_load_explicit(&c->fragmentos[i], memory_order_acquire);
+        if (f != NULL) total += atomic_load_explicit(&f->valor, memory_order_acquire);
+    }
+    return total;
+}
+
+static inline void contador_zerar(ContadorFragmentado *c) {
+    for (int i = 0; i < c->num_fragmentos; i++) {
+        FragmentoContador *f = atomic_load_explicit(&c->fragmentos[i], memory_order_acquire);
+        if (f != NULL) atomic_store(&f->valor, 0);
+    }
+}
+
+static inline void contador_destruir(ContadorFragmentado *c) {
+    for (int i = 0; i < c->num_fragmentos; i++) free(atomic_load(&c->fragmentos[i]));
+    free(c->fragmentos);
+    c->fragmentos = NULL;
+    c->num_fragmentos = 0;
+}
+
+#endif // CONTADOR_FRAGMENTADO_H
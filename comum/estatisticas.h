@@ -0,0 +1,69 @@
+#ifndef ESTATISTICAS_H
+#define ESTATISTICAS_H
+
+// Estatísticas completas em uma passada, como redução do OpenMP
+//
+// - Contagem, média, soma dos quadrados dos desvios (M2), mínimo e máximo
+// - Dentro da thread: atualização de Welford (estável, sem Σx² - n·média²)
+// - Entre threads: combinação de Chan et al., usada pela 'declare reduction' abaixo
+//
+// Uso:
+//   Estatisticas e = est_vazia();
+//   #pragma omp parallel for reduction(estat:e)
+//   for (...) est_adicionar(&e, valor);
+//   est_media(&e), est_desvio(&e), est_erro_padrao(&e), e.min, e.max
+
+#include <math.h>
+
+typedef struct {
+    long long n;
+    double media;
+    double m2;      // Σ (x - média)²
+    double min;
+    double max;
+} Estatisticas;
+
+static inline Estatisticas est_vazia(void) {
+    Estatisticas e = {0, 0.0, 0.0, INFINITY, -INFINITY};
+    return e;
+}
+
+// Welford: um valor por vez
+static inline void est_adicionar(Estatisticas *e, double x) {
+    e->n++;
+    double delta = x - e->media;
+    e->media += delta / e->n;
+    e->m2 += delta * (x - e->media);
+    if (x < e->min) e->min = x;
+    if (x > e->max) e->max = x;
+}
+
+// Chan et al.: junta os resumos de dois subconjuntos disjuntos
+static inline Estatisticas est_combinar(Estatisticas a, Estatisticas b) {
+    if (a.n == 0) return b;
+    if (b.n == 0) return a;
+    Estatisticas r;
+    r.n = a.n + b.n;
+    double delta = b.media - a.media;
+    r.media = a.media + delta * b.n / r.n;
+    r.m2 = a.m2 + b.m2 + delta * delta * ((double)a.n * b.n / r.n);
+    r.min = a.min < b.min ? a.min : b.min;
+    r.max = a.max > b.max ? a.max : b.max;
+    return r;
+}
+
+#pragma omp declare reduction(estat : Estatisticas : omp_out = est_combinar(omp_out, omp_in)) \
+    initializer(omp_priv = est_vazia())
+
+static inline double est_media(const Estatisticas *e) { return e->media; }
+static inline double est_soma(const Estatisticas *e) { return e->media * e->n; }
+static inline double est_soma_quadrados(const Estatisticas *e) { return e->m2 + e->n * e->media * e->media; }
+static inline double est_variancia(const Estatisticas *e) { return e->n > 1 ? e->m2 / (e->n - 1) : 0.0; }
+static inline double est_desvio(const Estatisticas *e) { return sqrt(est_variancia(e)); }
+
+// Erro-padrão da média: desvio / sqrt(n)
+static inline double est_erro_padrao(const Estatisticas *e) {
+    return e->n > 0 ? sqrt(est_variancia(e) / e->n) : 0.0;
+}
+
+#endif // ESTATISTICAS_H
@@ -0,0 +1,167 @@
+#ifndef MC_INTEGRACAO_H
+#define MC_INTEGRACAO_H
+
+// Integração de Monte Carlo genérica em caixas d-dimensionais (d <= MC_MAX_DIM)
+//
+// - Integrando: função escalar f(x) e, opcionalmente, uma versão em lote que recebe
+//   MC_LOTE pontos em layout SoA (x[k * n + i] = coordenada k do ponto i), fácil de vetorizar
+// - Fluxos: um xoshiro256++ (jump) por bloco de MC_PONTOS_POR_BLOCO pontos
+// - Uma passada: cada bloco acumula somas deslocadas de f e f²; os blocos são combinados
+//   em ordem (fórmula de Chan), então o resultado não depende do número de threads
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <omp.h>
+#include "rng.h"
+
+#define MC_MAX_DIM 32
+#define MC_LOTE 256                 // Pontos por chamada da versão em lote
+#define MC_PONTOS_POR_BLOCO 65536   // Um fluxo independente por bloco
+
+typedef double (*mc_funcao)(const double *x, int d, void *dados);
+typedef void (*mc_funcao_lote)(const double *x, int d, int n, double *saida, void *dados);
+
+typedef struct {
+    mc_funcao f;          // Obrigatória
+    mc_funcao_lote lote;  // NULL: usa f ponto a ponto
+    void *dados;          // Parâmetros repassados ao integrando
+} MCIntegrando;
+
+typedef struct {
+    int d;
+    double inf[MC_MAX_DIM];
+    double sup[MC_MAX_DIM];
+} MCDominio;
+
+typedef struct {
+    double integral;      // Volume * média de f
+    double erro_padrao;   // Volume * sqrt(Var(f) / n)
+    double media;
+    double variancia;     // Variância amostral de f
+    long long amostras;
+    double tempo;
+} MCResultado;
+
+// Média e soma dos quadrados dos desvios (M2) de um bloco
+typedef struct {
+    long long n;
+    double media;
+    double m2;
+} MCParcial;
+
+// Caixa [inf, sup]^d igual em todas as dimensões
+static inline MCDominio mc_dominio_cubo(int d, double inf, double sup) {
+    MCDominio dom;
+    dom.d = d;
+    for (int k = 0; k < d; k++) {
+        dom.inf[k] = inf;
+        dom.sup[k] = sup;
+    }
+    return dom;
+}
+
+static inline double mc_volume(const MCDominio *dom) {
+    double v = 1.0;
+    for (int k = 0; k < dom->d; k++) v *= dom->sup[k] - dom->inf[k];
+    return v;
+}
+
+// Junta dois parciais (Chan et al.): estável mesmo com médias muito diferentes
+static inline MCParcial mc_combinar(MCParcial a, MCParcial b) {
+    if (a.n == 0) return b;
+    if (b.n == 0) return a;
+    MCParcial r;
+    r.n = a.n + b.n;
+    double delta = b.media - a.media;
+    r.media = a.media + delta * b.n / r.n;
+    r.m2 = a.m2 + b.m2 + delta * delta * ((double)a.n * b.n / r.n);
+    return r;
+}
+
+// Um bloco: somas deslocadas pelo primeiro valor (evita cancelamento em Σf² - n·média²)
+static inline MCParcial mc_bloco(const MCIntegrando *g, const MCDominio *dom, Xoshiro256 *rng, long long pontos) {
+    const int d = dom->d;
+    double x[MC_MAX_DIM * MC_LOTE];
+    double saida[MC_LOTE];
+    double largura[MC_MAX_DIM];
+    for (int k = 0; k < d; k++) largura[k] = dom->sup[k] - dom->inf[k];
+
+    double desloc = 0.0, soma = 0.0, soma_q = 0.0;
+    int primeiro = 1;
+    for (long long inicio = 0; inicio < pontos; inicio += MC_LOTE) {
+        int n = pontos - inicio < MC_LOTE ? (int)(pontos - inicio) : MC_LOTE;
+        if (g->lote != NULL) {
+            for (int i = 0; i < n; i++) {     // Ordem dos números: ponto a ponto, igual à escalar
+                for (int k = 0; k < d; k++) {
+                    x[k * n + i] = dom->inf[k] + largura[k] * rng_u64_para_double(xoshiro256pp_proximo(rng));
+                }
+            }
+            g->lote(x, d, n, saida, g->dados);
+        } else {
+            for (int i = 0; i < n; i++) {
+                for (int k = 0; k < d; k++) {
+                    x[k] = dom->inf[k] + largura[k] * rng_u64_para_double(xoshiro256pp_proximo(rng));
+                }
+                saida[i] = g->f(x, d, g->dados);
+            }
+        }
+        if (primeiro) {
+            desloc = saida[0];
+            primeiro = 0;
+        }
+        for (int i = 0; i < n; i++) {
+            double v = saida[i] - desloc;
+            soma += v;
+            soma_q += v * v;
+        }
+    }
+
+    MCParcial p;
+    p.n = pontos;
+    p.media = desloc + soma / pontos;
+    p.m2 = soma_q - soma * soma / pontos;
+    if (p.m2 < 0.0) p.m2 = 0.0;
+    return p;
+}
+
+// Integra g em dom com n pontos (arredondado para blocos inteiros) e nthreads threads
+static inline MCResultado mc_integrar(const MCIntegrando *g, const MCDominio *dom, long long n,
+                                      uint64_t semente, int nthreads) {
+    if (dom->d < 1 || dom->d > MC_MAX_DIM) {
+        fprintf(stderr, "Dimensão %d fora do intervalo [1, %d]\n", dom->d, MC_MAX_DIM);
+        exit(1);
+    }
+    long long num_blocos = (n + MC_PONTOS_POR_BLOCO - 1) / MC_PONTOS_POR_BLOCO;
+    Xoshiro256 *fluxos = malloc(num_blocos * sizeof(Xoshiro256));
+    MCParcial *parciais = malloc(num_blocos * sizeof(MCParcial));
+    if (fluxos == NULL || parciais == NULL) {
+        fprintf(stderr, "Erro ao alocar memória para a integração\n");
+        exit(1);
+    }
+    xoshiro256_fluxos(fluxos, num_blocos, semente);
+
+    double start = omp_get_wtime();
+    #pragma omp parallel for num_threads(nthreads) schedule(static)
+    for (long long b = 0; b < num_blocos; b++) {
+        parciais[b] = mc_bloco(g, dom, &fluxos[b], MC_PONTOS_POR_BLOCO);
+    }
+    MCParcial total = {0, 0.0, 0.0};
+    for (long long b = 0; b < num_blocos; b++) total = mc_combinar(total, parciais[b]);
+    double tempo = omp_get_wtime() - start;
+
+    free(fluxos);
+    free(parciais);
+
+    MCResultado r;
+    double volume = mc_volume(dom);
+    r.amostras = total.n;
+    r.media = total.media;
+    r.variancia = total.n > 1 ? total.m2 / (total.n - 1) : 0.0;
+    r.integral = volume * r.media;
+    r.erro_padrao = volume * sqrt(r.variancia / total.n);
+    r.tempo = tempo;
+    return r;
+}
+
+#endif // MC_INTEGRACAO_H
@@ -0,0 +1,221 @@
+#ifndef MC_SIMD_H
+#define MC_SIMD_H
+
+// Kernel vetorizado de Monte Carlo para π: 8 (AVX2) ou 16 (AVX-512) pontos por iteração
+//
+// - Gerador: xoshiro128++ com um estado independente por lane (32 bits por lane)
+// - Conversão inteiro -> float sem divisão: (r >> 9) | 0x3F800000 é um float em [1, 2)
+// - Teste do círculo sem desvio: comparação vetorial -> máscara de bits -> popcount
+// - Seleção em tempo de execução entre AVX-512, AVX2 e versão escalar
+//
+// Cada bloco de pontos tem fluxos próprios derivados de (semente, bloco, lane) por splitmix64,
+// então, para o mesmo conjunto de instruções, o resultado não depende do número de threads.
+
+#include <stdint.h>
+#include <string.h>
+#include "rng.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define MC_SIMD_X86 1
+#endif
+
+#define MC_ISA_ESCALAR 0
+#define MC_ISA_AVX2 1
+#define MC_ISA_AVX512 2
+
+// Estado inicial da lane 'lane' do bloco 'bloco' (4 palavras de 32 bits, nunca todas zero)
+static inline void mc_simd_semear_lane(uint32_t estado[4], uint64_t semente, uint64_t bloco, int lane) {
+    uint64_t s = semente ^ (bloco * 0x9E3779B97F4A7C15ULL) ^ ((uint64_t)lane << 56);
+    uint64_t a = splitmix64(&s);
+    uint64_t b = splitmix64(&s);
+    estado[0] = (uint32_t)a;
+    estado[1] = (uint32_t)(a >> 32);
+    estado[2] = (uint32_t)b;
+    estado[3] = (uint32_t)(b >> 32) | 1u;
+}
+
+static inline uint32_t mc_rotl32(uint32_t x, int k) {
+    return (x << k) | (x >> (32 - k));
+}
+
+static inline uint32_t xoshiro128pp_proximo(uint32_t s[4]) {
+    uint32_t resultado = mc_rotl32(s[0] + s[3], 7) + s[0];
+    uint32_t t = s[1] << 9;
+    s[2] ^= s[0];
+    s[3] ^= s[1];
+    s[1] ^= s[2];
+    s[0] ^= s[3];
+    s[2] ^= t;
+    s[3] = mc_rotl32(s[3], 11);
+    return resultado;
+}
+
+static inline float mc_bits_para_float(uint32_t r) {
+    uint32_t bits = (r >> 9) | 0x3F800000u;  // Expoente de 1.0, mantissa aleatória
+    float f;
+    memcpy(&f, &bits, sizeof(f));
+    return f - 1.0f;                         // [0, 1)
+}
+
+// Referência escalar: uma lane, mesma conversão e mesmo teste
+static inline long long mc_contar_escalar(uint64_t semente, uint64_t bloco, long long pontos) {
+    uint32_t s[4];
+    mc_simd_semear_lane(s, semente, bloco, 0);
+    long long dentro = 0;
+    for (long long i = 0; i < pontos; i++) {
+        float x = mc_bits_para_float(xoshiro128pp_proximo(s));
+        float y = mc_bits_para_float(xoshiro128pp_proximo(s));
+        dentro += (x * x + y * y <= 1.0f);   // Soma do booleano: sem desvio
+    }
+    return dentro;
+}
+
+#ifdef MC_SIMD_X86
+
+// ---------------------------------------------------------------------------
+// AVX2: 8 lanes de 32 bits
+// ---------------------------------------------------------------------------
+__attribute__((target("avx2")))
+static inline __m256i mc_rotl_avx2(__m256i x, int k) {
+    return _mm256_or_si256(_mm256_slli_epi32(x, k), _mm256_srli_epi32(x, 32 - k));
+}
+
+__attribute__((target("avx2")))
+static inline __m256i mc_proximo_avx2(__m256i s[4]) {
+    __m256i resultado = _mm256_add_epi32(mc_rotl_avx2(_mm256_add_epi32(s[0], s[3]), 7), s[0]);
+    __m256i t = _mm256_slli_epi32(s[1], 9);
+    s[2] = _mm256_xor_si256(s[2], s[0]);
+    s[3] = _mm256_xor_si256(s[3], s[1]);
+    s[1] = _mm256_xor_si256(s[1], s[2]);
+    s[0] = _mm256_xor_si256(s[0], s[3]);
+    s[2] = _mm256_xor_si256(s[2], t);
+    s[3] = mc_rotl_avx2(s[3], 11);
+    return resultado;
+}
+
+__attribute__((target("avx2")))
+static inline __m256 mc_para_float_avx2(__m256i r) {
+    __m256i bits = _mm256_or_si256(_mm256_srli_epi32(r, 9), _mm256_set1_epi32(0x3F800000));
+    return _mm256_sub_ps(_mm256_castsi256_ps(bits), _mm256_set1_ps(1.0f));
+}
+
+__attribute__((target("avx2,popcnt")))
+static long long mc_contar_avx2(uint64_t semente, uint64_t bloco, long long pontos) {
+    uint32_t inicial[4][8];
+    for (int lane = 0; lane < 8; lane++) {
+        uint32_t e[4];
+        mc_simd_semear_lane(e, semente, bloco, lane);
+        for (int k = 0; k < 4; k++) inicial[k][lane] = e[k];
+    }
+    __m256i s[4];
+    for (int k = 0; k < 4; k++) s[k] = _mm256_loadu_si256((const __m256i *)inicial[k]);
+
+    const __m256 um = _mm256_set1_ps(1.0f);
+    long long dentro = 0;
+    long long i = 0;
+    for (; i + 8 <= pontos; i += 8) {
+        __m256 x = mc_para_float_avx2(mc_proximo_avx2(s));
+        __m256 y = mc_para_float_avx2(mc_proximo_avx2(s));
+        __m256 r2 = _mm256_add_ps(_mm256_mul_ps(x, x), _mm256_mul_ps(y, y));
+        int mascara = _mm256_movemask_ps(_mm256_cmp_ps(r2, um, _CMP_LE_OQ));
+        dentro += __builtin_popcount(mascara);
+    }
+    if (i < pontos) {                        // Cauda: descarta as lanes excedentes
+        __m256 x = mc_para_float_avx2(mc_proximo_avx2(s));
+        __m256 y = mc_para_float_avx2(mc_proximo_avx2(s));
+        __m256 r2 = _mm256_add_ps(_mm256_mul_ps(x, x), _mm256_mul_ps(y, y));
+        int mascara = _mm256_movemask_ps(_mm256_cmp_ps(r2, um, _CMP_LE_OQ));
+        dentro += __builtin_popcount(mascara & ((1 << (pontos - i)) - 1));
+    }
+    return dentro;
+}
+
+// ---------------------------------------------------------------------------
+// AVX-512: 16 lanes de 32 bits, rotação nativa e comparação direto em máscara
+// ---------------------------------------------------------------------------
+__attribute__((target("avx512f")))
+static inline __m512i mc_proximo_avx512(__m512i s[4]) {
+    __m512i resultado = _mm512_add_epi32(_mm512_rol_epi32(_mm512_add_epi32(s[0], s[3]), 7), s[0]);
+    __m512i t = _mm512_slli_epi32(s[1], 9);
+    s[2] = _mm512_xor_si512(s[2], s[0]);
+    s[3] = _mm512_xor_si512(s[3], s[1]);
+    s[1] = _mm512_xor_si512(s[1], s[2]);
+    s[0] = _mm512_xor_si512(s[0], s[3]);
+    s[2] = _mm512_xor_si512(s[2], t);
+    s[3] = _mm512_rol_epi32(s[3], 11);
+    return resultado;
+}
+
+__attribute__((target("avx512f")))
+static inline __m512 mc_para_float_avx512(__m512i r) {
+    __m512i bits = _mm512_or_si512(_mm512_srli_epi32(r, 9), _mm512_set1_epi32(0x3F800000));
+    return _mm512_sub_ps(_mm512_castsi512_ps(bits), _mm512_set1_ps(1.0f));
+}
+
+__attribute__((target("avx512f,popcnt")))
+static long long mc_contar_avx512(uint64_t semente, uint64_t bloco, long long pontos) {
+    uint32_t inicial[4][16];
+    for (int lane = 0; lane < 16; lane++) {
+        uint32_t e[4];
+        mc_simd_semear_lane(e, semente, bloco, lane);
+        for (int k = 0; k < 4; k++) inicial[k][lane] = e[k];
+    }
+    __m512i s[4];
+    for (int k = 0; k < 4; k++) s[k] = _mm512_loadu_si512(inicial[k]);
+
+    const __m512 um = _mm512_set1_ps(1.0f);
+    long long dentro = 0;
+    long long i = 0;
+    for (; i + 16 <= pontos; i += 16) {
+        __m512 x = mc_para_float_avx512(mc_proximo_avx512(s));
+        __m512 y = mc_para_float_avx512(mc_proximo_avx512(s));
+        __m512 r2 = _mm512_fmadd_ps(x, x, _mm512_mul_ps(y, y));
+        __mmask16 mascara = _mm512_cmp_ps_mask(r2, um, _CMP_LE_OQ);
+        dentro += __builtin_popcount((unsigned)mascara);
+    }
+    if (i < pontos) {
+        __m512 x = mc_para_float_avx512(mc_proximo_avx512(s));
+        __m512 y = mc_para_float_avx512(mc_proximo_avx512(s));
+        __m512 r2 = _mm512_fmadd_ps(x, x, _mm512_mul_ps(y, y));
+        __mmask16 mascara = _mm512_cmp_ps_mask(r2, um, _CMP_LE_OQ);
+        dentro += __builtin_popcount((unsigned)mascara & ((1u << (pontos - i)) - 1));
+    }
+    return dentro;
+}
+
+#endif // MC_SIMD_X86
+
+// ---------------------------------------------------------------------------
+// Seleção em tempo de execução
+// ---------------------------------------------------------------------------
+typedef long long (*mc_kernel_fn)(uint64_t semente, uint64_t bloco, long long pontos);
+
+// Melhor conjunto de instruções disponível nesta CPU
+static inline int mc_simd_isa_detectada(void) {
+#ifdef MC_SIMD_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f")) return MC_ISA_AVX512;
+    if (__builtin_cpu_supports("avx2")) return MC_ISA_AVX2;
+#endif
+    return MC_ISA_ESCALAR;
+}
+
+// Kernel para um conjunto de instruções (recai para o escalar se não suportado)
+static inline mc_kernel_fn mc_simd_kernel(int isa) {
+#ifdef MC_SIMD_X86
+    int disponivel = mc_simd_isa_detectada();
+    if (isa > disponivel) isa = disponivel;
+    if (isa == MC_ISA_AVX512) return mc_contar_avx512;
+    if (isa == MC_ISA_AVX2) return mc_contar_avx2;
+#endif
+    (void)isa;
+    return mc_contar_escalar;
+}
+
+static inline const char *mc_simd_nome(int isa) {
+    static const char *nomes[] = {"escalar", "AVX2 (8 lanes)", "AVX-512 (16 lanes)"};
+    return nomes[isa];
+}
+
+#endif // MC_SIMD_H
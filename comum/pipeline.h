@@ -0,0 +1,386 @@
+#ifndef PIPELINE_H
+#define PIPELINE_H
+
+// Pipeline de estágios com filas limitadas sem trava
+//
+// - Cada estágio tem uma função e um número próprio de threads
+// - Estágios vizinhos se ligam por uma fila circular limitada (Vyukov): um número de sequência
+//   por célula. Com 1 produtor e 1 consumidor a fila vira SPSC (store no lugar do CAS)
+// - Lotes: o que trafega na fila é um lote de até 'lote' itens. Cada thread junta a sua saída
+//   num lote local e só empurra quando ele enche ou quando a própria entrada esvazia
+// - Contrapressão: fila cheia bloqueia o produtor (pause/yield), então a memória em trânsito
+//   fica limitada a capacidade × lote itens por fila
+// - Término: cada fila conta os produtores ativos; um consumidor termina quando a fila está
+//   vazia e não há mais produtores
+// - Estatísticas por estágio (itens, tempo ocupado, espera por entrada e por saída) e por fila
+//   (ocupação média e máxima, amostrada a cada lote retirado)
+//
+// Uso:
+//   PipeEstagio e[] = {{.nome = "ler", .threads = 2, .funcao = ler, .arg = &ctx}, ...};
+//   Pipeline p; pipe_criar(&p, e, 4, 64, 16);
+//   double tempo = pipe_executar(&p); pipe_relatorio(&p, tempo); pipe_destruir(&p);
+// O primeiro estágio recebe item NULL e devolve 0 quando não tem mais o que produzir.
+
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdatomic.h>
+#include <pthread.h>
+#include <sched.h>
+#include <time.h>
+
+#define PIPE_LOTE_MAX 64
+#define PIPE_LINHA 128
+#define PIPE_FALHAS_ATE_YIELD 64
+
+typedef struct {
+    int n;
+    void *itens[PIPE_LOTE_MAX];
+} PipeLote;
+
+typedef struct {
+    atomic_size_t sequencia;
+    PipeLote *lote;
+} PipeCelula;
+
+typedef struct {
+    _Alignas(PIPE_LINHA) atomic_size_t cauda;     // Próxima posição a escrever (produtores)
+    _Alignas(PIPE_LINHA) atomic_size_t cabeca;    // Próxima posição a ler (consumidores)
+    _Alignas(PIPE_LINHA) PipeCelula *celulas;
+    size_t mascara;
+    int spsc;
+    atomic_int produtores_ativos;
+    atomic_llong soma_ocupacao;                  // Amostras tiradas pelos consumidores
+    atomic_llong amostras;
+    atomic_llong ocupacao_maxima;
+} PipeFila;
+
+typedef struct PipeSaida PipeSaida;
+
+// Estágio: 'funcao' processa um item e emite zero ou mais itens com pipe_emitir.
+// No primeiro estágio o item é NULL e o retorno 0 encerra a thread.
+typedef int (*pipe_funcao)(void *item, PipeSaida *saida, void *arg);
+
+typedef struct {
+    const char *nome;
+    int threads;
+    pipe_funcao funcao;
+    void *arg;
+    // Estatísticas (somadas pelas threads ao terminar)
+    atomic_llong itens;
+    atomic_llong ns_ocupado;
+    atomic_llong ns_espera_entrada;
+    atomic_llong ns_espera_saida;
+} PipeEstagio;
+
+typedef struct {
+    int num_estagios;
+    PipeEstagio *estagios;
+    PipeFila *filas;              // num_estagios - 1 filas; filas[k] liga o estágio k ao k + 1
+    size_t capacidade;            // Lotes por fila (potência de 2)
+    int lote;
+} Pipeline;
+
+struct PipeSaida {
+    Pipeline *p;
+    int estagio;
+    PipeLote *atual;
+    long long ns_espera;          // Tempo bloqueado com a fila de saída cheia
+};
+
+typedef struct {
+    Pipeline *p;
+    int estagio;
+} PipeArgThread;
+
+static inline long long pipe_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (long long)ts.tv_sec * 1000000000LL + ts.tv_nsec;
+}
+
+static inline void pipe_pausa(int *falhas) {
+    if (++*falhas < PIPE_FALHAS_ATE_YIELD) {
+#if defined(__x86_64__) || defined(__i386__)
+        __builtin_ia32_pause();
+#endif
+    } else {
+        sched_yield();
+        *falhas = 0;
+    }
+}
+
+// ---------------------------------------------------------------------------
+// Fila limitada (Vyukov). Célula livre para a posição 'pos' tem sequencia == pos;
+// célula cheia tem sequencia == pos + 1.
+// ---------------------------------------------------------------------------
+static inline void pipe_fila_iniciar(PipeFila *f, size_t capacidade, int produtores, int consumidores) {
+    f->celulas = malloc(capacidade * sizeof(PipeCelula));
+    if (f->celulas == NULL) {
+        fprintf(stderr, "Erro ao alocar memória para a fila\n");
+        exit(1);
+    }
+    for (size_t i = 0; i < capacidade; i++) {
+        atomic_init(&f->celulas[i].sequencia, i);
+        f->celulas[i].lote = NULL;
+    }
+    f->mascara = capacidade - 1;
+    f->spsc = produtores == 1 && consumidores == 1;
+    atomic_init(&f->cauda, 0);
+    atomic_init(&f->cabeca, 0);
+    atomic_init(&f->produtores_ativos, produtores);
+    atomic_init(&f->soma_ocupacao, 0);
+    atomic_init(&f->amostras, 0);
+    atomic_init(&f->ocupacao_maxima, 0);
+}
+
+static inline int pipe_fila_empurrar(PipeFila *f, PipeLote *lote) {
+    size_t pos = atomic_load_explicit(&f->cauda, memory_order_relaxed);
+    PipeCelula *c;
+    for (;;) {
+        c = &f->celulas[pos & f->mascara];
+        size_t seq = atomic_load_explicit(&c->sequencia, memory_order_acquire);
+        intptr_t diferenca = (intptr_t)seq - (intptr_t)pos;
+        if (diferenca == 0) {
+            if (f->spsc) {
+                atomic_store_explicit(&f->cauda, pos + 1, memory_order_relaxed);
+                break;
+            }
+            if (atomic_compare_exchange_weak_explicit(&f->cauda, &pos, pos + 1, memory_order_relaxed,
+                                                      memory_order_relaxed)) break;
+        } else if (diferenca < 0) {
+            return 0;                                    // Cheia
+        } else {
+            pos = atomic_load_explicit(&f->cauda, memory_order_relaxed);
+        }
+    }
+    c->lote = lote;
+    atomic_store_explicit(&c->sequencia, pos + 1, memory_order_release);
+    return 1;
+}
+
+static inline int pipe_fila_retirar(PipeFila *f, PipeLote **lote) {
+    size_t pos = atomic_load_explicit(&f->cabeca, memory_order_relaxed);
+    PipeCelula *c;
+    for (;;) {
+        c = &f->celulas[pos & f->mascara];
+        size_t seq = atomic_load_explicit(&c->sequencia, memory_order_acquire);
+        intptr_t diferenca = (intptr_t)seq - (intptr_t)(pos + 1);
+        if (diferenca == 0) {
+            if (f->spsc) {
+                atomic_store_explicit(&f->cabeca, pos + 1, memory_order_relaxed);
+                break;
+            }
+            if (atomic_compare_exchange_weak_explicit(&f->cabeca, &pos, pos + 1, memory_order_relaxed,
+                                                      memory_order_relaxed)) break;
+        } else if (diferenca < 0) {
+            return 0;                                    // Vazia
+        } else {
+            pos = atomic_load_explicit(&f->cabeca, memory_order_relaxed);
+        }
+    }
+    *lote = c->lote;
+    atomic_store_explicit(&c->sequencia, pos + f->mascara + 1, memory_order_release);
+    return 1;
+}
+
+// Ocupação aproximada em lotes (as duas leituras não são simultâneas)
+static inline long long pipe_fila_ocupacao(PipeFila *f) {
+    long long n = (long long)atomic_load_explicit(&f->cauda, memory_order_relaxed) -
+                  (long long)atomic_load_explicit(&f->cabeca, memory_order_relaxed);
+    return n < 0 ? 0 : n;
+}
+
+// ---------------------------------------------------------------------------
+// Saída de uma thread: lote local, empurrado com contrapressão
+// ---------------------------------------------------------------------------
+static inline PipeLote *pipe_lote_novo(void) {
+    PipeLote *l = malloc(sizeof(PipeLote));
+    if (l == NULL) {
+        fprintf(stderr, "Erro ao alocar memória para o lote\n");
+        exit(1);
+    }
+    l->n = 0;
+    return l;
+}
+
+static inline void pipe_descarregar(PipeSaida *s) {
+    if (s->atual == NULL || s->atual->n == 0) return;
+    PipeFila *f = &s->p->filas[s->estagio];
+    if (!pipe_fila_empurrar(f, s->atual)) {
+        long long inicio = pipe_ns();
+        int falhas = 0;
+        do pipe_pausa(&falhas);
+        while (!pipe_fila_empurrar(f, s->atual));
+        s->ns_espera += pipe_ns() - inicio;
+    }
+    s->atual = NULL;
+}
+
+static inline void pipe_emitir(PipeSaida *s, void *item) {
+    if (s->estagio == s->p->num_estagios - 1) return;    // Último estágio: nada depois dele
+    if (s->atual == NULL) s->atual = pipe_lote_novo();
+    s->atual->itens[s->atual->n++] = item;
+    if (s->atual->n == s->p->lote) pipe_descarregar(s);
+}
+
+// ---------------------------------------------------------------------------
+// Threads dos estágios
+// ---------------------------------------------------------------------------
+static inline void *pipe_laco_estagio(void *p_arg) {
+    PipeArgThread *arg = p_arg;
+    Pipeline *p = arg->p;
+    int k = arg->estagio;
+    free(arg);
+    PipeEstagio *e = &p->estagios[k];
+    PipeFila *entrada = k > 0 ? &p->filas[k - 1] : NULL;
+    PipeSaida saida = {p, k, NULL, 0};
+    long long itens = 0, ns_ocupado = 0, ns_espera_entrada = 0;
+    long long soma_ocupacao = 0, amostras = 0, maxima = 0;
+
+    if (entrada == NULL) {
+        for (;;) {
+            long long inicio = pipe_ns(), espera_antes = saida.ns_espera;
+            int continuar = e->funcao(NULL, &saida, e->arg);
+            ns_ocupado += pipe_ns() - inicio - (saida.ns_espera - espera_antes);  // Espera de saída não é trabalho
+            if (!continuar) break;
+            itens++;
+        }
+    } else {
+        for (;;) {
+            PipeLote *lote;
+            if (!pipe_fila_retirar(entrada, &lote)) {
+                // Entrada vazia: entrega o lote parcial antes de esperar, senão o estágio
+                // seguinte pode ficar parado enquanto este espera
+                pipe_descarregar(&saida);
+                long long inicio = pipe_ns();
+                int falhas = 0, fim = 0;
+                while (!pipe_fila_retirar(entrada, &lote)) {
+                    if (atomic_load_explicit(&entrada->produtores_ativos, memory_order_acquire) == 0) {
+                        if (!pipe_fila_retirar(entrada, &lote)) fim = 1;
+                        break;
+                    }
+                    pipe_pausa(&falhas);
+                }
+                ns_espera_entrada += pipe_ns() - inicio;
+                if (fim) break;
+            }
+            long long ocupacao = pipe_fila_ocupacao(entrada) + 1;   // Inclui o lote retirado
+            soma_ocupacao += ocupacao;
+            amostras++;
+            if (ocupacao > maxima) maxima = ocupacao;
+
+            long long inicio = pipe_ns(), espera_antes = saida.ns_espera;
+            for (int i = 0; i < lote->n; i++) e->funcao(lote->itens[i], &saida, e->arg);
+            ns_ocupado += pipe_ns() - inicio - (saida.ns_espera - espera_antes);
+            itens += lote->n;
+            free(lote);
+        }
+    }
+    pipe_descarregar(&saida);
+    if (saida.atual != NULL) free(saida.atual);
+    if (k < p->num_estagios - 1) {
+        atomic_fetch_sub_explicit(&p->filas[k].produtores_ativos, 1, memory_order_release);
+    }
+
+    atomic_fetch_add(&e->itens, itens);
+    atomic_fetch_add(&e->ns_ocupado, ns_ocupado);
+    atomic_fetch_add(&e->ns_espera_entrada, ns_espera_entrada);
+    atomic_fetch_add(&e->ns_espera_saida, saida.ns_espera);
+    if (entrada != NULL) {
+        atomic_fetch_add(&entrada->soma_ocupacao, soma_ocupacao);
+        atomic_fetch_add(&entrada->amostras, amostras);
+        long long atual = atomic_load(&entrada->ocupacao_maxima);
+        while (maxima > atual && !atomic_compare_exchange_weak(&entrada->ocupacao_maxima, &atual, maxima)) {}
+    }
+    return NULL;
+}
+
+// 'capacidade' em lotes (arredondada para potência de 2), 'lote' em itens (até PIPE_LOTE_MAX)
+static inline void pipe_criar(Pipeline *p, PipeEstagio *estagios, int num_estagios, size_t capacidade, int lote) {
+    p->num_estagios = num_estagios;
+    p->estagios = estagios;
+    size_t c = 2;
+    while (c < capacidade) c *= 2;
+    p->capacidade = c;
+    p->lote = lote < 1 ? 1 : (lote > PIPE_LOTE_MAX ? PIPE_LOTE_MAX : lote);
+    p->filas = NULL;
+    if (num_estagios > 1 && posix_memalign((void **)&p->filas, PIPE_LINHA, (num_estagios - 1) * sizeof(PipeFila)) != 0) {
+        fprintf(stderr, "Erro ao alocar memória para as filas\n");
+        exit(1);
+    }
+    for (int k = 0; k < num_estagios; k++) {
+        PipeEstagio *e = &estagios[k];
+        if (e->threads < 1) e->threads = 1;
+        atomic_init(&e->itens, 0);
+        atomic_init(&e->ns_ocupado, 0);
+        atomic_init(&e->ns_espera_entrada, 0);
+        atomic_init(&e->ns_espera_saida, 0);
+        if (k < num_estagios - 1) pipe_fila_iniciar(&p->filas[k], c, e->threads, estagios[k + 1].threads);
+    }
+}
+
+// Roda o pipeline até o primeiro estágio se esgotar e as filas esvaziarem; devolve o tempo em s
+static inline double pipe_executar(Pipeline *p) {
+    int total = 0;
+    for (int k = 0; k < p->num_estagios; k++) total += p->estagios[k].threads;
+    pthread_t *threads = malloc(total * sizeof(pthread_t));
+    if (threads == NULL) {
+        fprintf(stderr, "Erro ao alocar memória para as threads\n");
+        exit(1);
+    }
+    long long inicio = pipe_ns();
+    int t = 0;
+    for (int k = 0; k < p->num_estagios; k++) {
+        for (int i = 0; i < p->estagios[k].threads; i++) {
+            PipeArgThread *arg = malloc(sizeof(PipeArgThread));
+            if (arg == NULL) {
+                fprintf(stderr, "Erro ao alocar memória para as threads\n");
+                exit(1);
+            }
+            arg->p = p;
+            arg->estagio = k;
+            if (pthread_create(&threads[t++], NULL, pipe_laco_estagio, arg) != 0) {
+                fprintf(stderr, "Erro ao criar thread do estágio %s\n", p->estagios[k].nome);
+                exit(1);
+            }
+        }
+    }
+    for (int i = 0; i < t; i++) pthread_join(threads[i], NULL);
+    free(threads);
+    return (pipe_ns() - inicio) / 1e9;
+}
+
+static inline void pipe_relatorio(Pipeline *p, double tempo) {
+    printf("%-12s %-8s %-10s %-12s %-10s %-12s %-12s\n", "Estagio", "Threads", "Itens", "Itens/s",
+           "Ocupado", "Esp. entrada", "Esp. saida");
+    for (int k = 0; k < p->num_estagios; k++) {
+        PipeEstagio *e = &p->estagios[k];
+        double capacidade_ns = e->threads * tempo * 1e9;   // Tempo total das threads do estágio
+        char ocupado[16], entrada[16], saida[16];
+        snprintf(ocupado, sizeof(ocupado), "%.1f%%", 100.0 * atomic_load(&e->ns_ocupado) / capacidade_ns);
+        snprintf(entrada, sizeof(entrada), "%.1f%%", 100.0 * atomic_load(&e->ns_espera_entrada) / capacidade_ns);
+        snprintf(saida, sizeof(saida), "%.1f%%", 100.0 * atomic_load(&e->ns_espera_saida) / capacidade_ns);
+        printf("%-12s %-8d %-10lld %-12.0f %-10s %-12s %-12s\n", e->nome, e->threads, (long long)atomic_load(&e->itens),
+               atomic_load(&e->itens) / tempo, ocupado, k > 0 ? entrada : "-", saida);
+    }
+    printf("%-22s %-8s %-12s %-14s %-8s\n", "Fila", "Tipo", "Capacidade", "Ocup. media", "Maxima");
+    for (int k = 0; k < p->num_estagios - 1; k++) {
+        PipeFila *f = &p->filas[k];
+        char nome[64];
+        snprintf(nome, sizeof(nome), "%s -> %s", p->estagios[k].nome, p->estagios[k + 1].nome);
+        long long amostras = atomic_load(&f->amostras);
+        printf("%-22s %-8s %-12zu %-14.1f %-8lld\n", nome, f->spsc ? "SPSC" : "MPMC", p->capacidade,
+               amostras > 0 ? (double)atomic_load(&f->soma_ocupacao) / amostras : 0.0,
+               (long long)atomic_load(&f->ocupacao_maxima));
+    }
+}
+
+static inline void pipe_destruir(Pipeline *p) {
+    for (int k = 0; k < p->num_estagios - 1; k++) free(p->filas[k].celulas);
+    free(p->filas);
+    p->filas = NULL;
+}
+
+#endif // PIPELINE_H
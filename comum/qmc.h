@@ -0,0 +1,105 @@
+#ifndef QMC_H
+#define QMC_H
+
+// Sequências de baixa discrepância para quasi-Monte Carlo (QMC)
+//
+// - Sobol 2D em ordem de código Gray: o ponto i+1 sai do ponto i com um único XOR
+// - Halton (bases 2 e 3) com dígitos inteiros exatos
+//
+// Ambas permitem saltar direto para o índice i (skip-ahead), então cada thread começa no
+// próprio trecho da sequência. O erro cai ~ (log N)^2 / N em vez de 1 / sqrt(N).
+// Para estimar o erro, cada réplica aplica uma aleatorização independente:
+// deslocamento digital (XOR) no Sobol e rotação de Cranley-Patterson no Halton.
+
+#include <stdint.h>
+
+// ---------------------------------------------------------------------------
+// Sobol 2D
+// ---------------------------------------------------------------------------
+typedef struct {
+    uint32_t v[2][32];   // Números de direção (32 bits de precisão)
+} Sobol2D;
+
+static inline void sobol2d_init(Sobol2D *s) {
+    // Dimensão 1: van der Corput na base 2
+    // Dimensão 2: polinômio primitivo x + 1, m1 = 1  ->  v_k = v_{k-1} ^ (v_{k-1} >> 1)
+    s->v[1][0] = 1u << 31;
+    for (int k = 0; k < 32; k++) {
+        s->v[0][k] = 1u << (31 - k);
+        if (k > 0) s->v[1][k] = s->v[1][k - 1] ^ (s->v[1][k - 1] >> 1);
+    }
+}
+
+// Ponto i (ordem Gray) calculado diretamente: usado para saltar ao início do trecho
+static inline void sobol2d_ponto(const Sobol2D *s, uint64_t i, uint32_t *x, uint32_t *y) {
+    uint64_t g = i ^ (i >> 1);
+    uint32_t a = 0, b = 0;
+    for (int k = 0; g != 0 && k < 32; k++, g >>= 1) {
+        if (g & 1) {
+            a ^= s->v[0][k];
+            b ^= s->v[1][k];
+        }
+    }
+    *x = a;
+    *y = b;
+}
+
+// Passa do ponto i para o ponto i+1: no código Gray muda só o bit ctz(i+1)
+static inline void sobol2d_avancar(const Sobol2D *s, uint64_t i, uint32_t *x, uint32_t *y) {
+    int c = __builtin_ctzll(i + 1);
+    *x ^= s->v[0][c];
+    *y ^= s->v[1][c];
+}
+
+// ---------------------------------------------------------------------------
+// Halton: inverso radical com dígitos em inteiro (sem acumular erro de arredondamento)
+// ---------------------------------------------------------------------------
+typedef struct {
+    uint32_t base;
+    int num_digitos;        // K: denominador = base^K cabe em uint64_t
+    uint64_t denominador;
+    uint64_t peso[64];      // peso[k] = base^(K-1-k)
+    uint8_t digito[64];
+    uint64_t valor;         // Inverso radical * denominador
+} Halton;
+
+// Posiciona no índice i (skip-ahead em O(log i))
+static inline void halton_init(Halton *h, uint32_t base, uint64_t i) {
+    h->base = base;
+    h->num_digitos = 0;
+    uint64_t d = 1;
+    while (d <= UINT64_MAX / base) {
+        d *= base;
+        h->num_digitos++;
+    }
+    h->denominador = d;
+    for (int k = 0; k < h->num_digitos; k++) {
+        d /= base;
+        h->peso[k] = d;
+    }
+    h->valor = 0;
+    for (int k = 0; k < h->num_digitos; k++) {
+        h->digito[k] = (uint8_t)(i % base);
+        h->valor += h->digito[k] * h->peso[k];
+        i /= base;
+    }
+}
+
+static inline double halton_valor(const Halton *h) {
+    return (double)h->valor / (double)h->denominador;
+}
+
+// Incremento com vai-um: em média 1 + 1/(base-1) dígitos alterados
+static inline void halton_avancar(Halton *h) {
+    for (int k = 0; k < h->num_digitos; k++) {
+        if (h->digito[k] + 1u < h->base) {
+            h->digito[k]++;
+            h->valor += h->peso[k];
+            return;
+        }
+        h->valor -= (uint64_t)(h->base - 1) * h->peso[k];
+        h->digito[k] = 0;
+    }
+}
+
+#endif // QMC_H
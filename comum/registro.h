@@ -0,0 +1,300 @@
+#ifndef REGISTRO_H
+#define REGISTRO_H
+
+// Registro (log) sem trava para código paralelo, no lugar de printf dentro de tasks e regiões críticas
+//
+// - Cada thread escreve num anel próprio de registros de tamanho fixo (SPSC: a thread produz,
+//   a descarregadora consome). Sem espera: com o anel cheio o registro é descartado e contado
+// - Cada registro leva o instante (ns desde REGISTRO_INICIAR) e o número da thread no registro
+// - Uma thread descarregadora acorda a cada 'intervalo' segundos, intercala os anéis pelo
+//   instante e escreve tudo com writev, direto das posições dos anéis
+// - REGISTRO_SINCRONIZAR() descarrega na hora (depois de fflush(stdout)): chamar antes de voltar
+//   a usar printf, para as linhas saírem na ordem certa
+// - Fora de uma sessão (antes de REGISTRO_INICIAR ou depois de REGISTRO_FINALIZAR), REGISTRAR
+//   vira printf. Cada sessão tem uma geração: o ponteiro __thread de uma sessão anterior é
+//   descartado no primeiro REGISTRAR da nova, e a thread reserva outro anel
+// - REGISTRO_FINALIZAR só depois que as threads pararam de registrar (os anéis são liberados)
+// - Compilar com -DREGISTRO_DESATIVADO remove as chamadas: nenhum código é gerado e os
+//   argumentos nem são avaliados
+//
+// Uso:
+//   REGISTRO_INICIAR(STDOUT_FILENO, 0.05);
+//   #pragma omp parallel { ... REGISTRAR("Thread %d: %ld pontos\n", tid, n); ... }
+//   REGISTRO_SINCRONIZAR();
+//   ...
+//   REGISTRO_FINALIZAR();
+
+#ifndef REGISTRO_DESATIVADO
+
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdarg.h>
+#include <stdint.h>
+#include <string.h>
+#include <stdatomic.h>
+#include <pthread.h>
+#include <time.h>
+#include <errno.h>
+#include <unistd.h>
+#include <sys/uio.h>
+
+#define REGISTRO_MAX_THREADS 256
+#define REGISTRO_CAPACIDADE 4096        // Registros por anel (potência de 2)
+#define REGISTRO_TEXTO 112              // Bytes de texto por registro (o resto é truncado)
+#define REGISTRO_LOTE_IOV 512           // iovecs por writev (2 por registro)
+
+typedef struct {
+    uint64_t instante_ns;
+    uint16_t thread;
+    uint16_t tamanho;
+    char texto[REGISTRO_TEXTO];
+} Registro;
+
+typedef struct {
+    _Alignas(128) atomic_size_t cauda;      // Escrito pela thread dona
+    _Alignas(128) atomic_size_t cabeca;     // Escrito pela descarregadora
+    size_t perdidos;                        // Registros descartados com o anel cheio (só a dona)
+    Registro registros[REGISTRO_CAPACIDADE];
+} AnelRegistro;
+
+typedef struct {
+    _Atomic(AnelRegistro *) aneis[REGISTRO_MAX_THREADS];
+    atomic_int num_aneis;
+    int fd;
+    double intervalo;
+    uint64_t inicio_ns;
+    int ativo;                               // Protegido por trava
+    pthread_mutex_t trava;                   // Serializa as descargas (nunca tomada por quem registra)
+    pthread_cond_t parar;
+    pthread_t descarregadora;
+} EstadoRegistro;
+
+static EstadoRegistro registro_estado;
+static atomic_uint registro_geracao;                  // Ímpar: sessão ativa; par: finalizado ou não iniciado
+static __thread AnelRegistro *registro_anel = NULL;
+static __thread int registro_id = -1;
+static __thread unsigned registro_geracao_anel = 0;  // Geração em que registro_anel foi reservado
+
+static inline uint64_t registro_agora_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+// Primeira chamada de uma thread na sessão: reserva um anel. NULL fora de uma sessão
+static inline AnelRegistro *registro_anel_da_thread(void) {
+    unsigned geracao = atomic_load_explicit(&registro_geracao, memory_order_acquire);
+    if (geracao == registro_geracao_anel) return registro_anel;
+    if ((geracao & 1) == 0) return NULL;
+    int id = atomic_fetch_add(&registro_estado.num_aneis, 1);
+    if (id >= REGISTRO_MAX_THREADS) {
+        fprintf(stderr, "Registro: mais de %d threads\n", REGISTRO_MAX_THREADS);
+        exit(1);
+    }
+    AnelRegistro *a;
+    if (posix_memalign((void **)&a, 128, sizeof(AnelRegistro)) != 0) {
+        fprintf(stderr, "Erro ao alocar memória para o anel de registro\n");
+        exit(1);
+    }
+    atomic_init(&a->cauda, 0);
+    atomic_init(&a->cabeca, 0);
+    a->perdidos = 0;
+    atomic_store_explicit(&registro_estado.aneis[id], a, memory_order_release);
+    registro_anel = a;
+    registro_id = id;
+    registro_geracao_anel = geracao;
+    return a;
+}
+
+__attribute__((format(printf, 1, 2)))
+static inline void registro_escrever(const char *formato, ...) {
+    AnelRegistro *a = registro_anel_da_thread();
+    if (a == NULL) {
+        va_list args;
+        va_start(args, formato);
+        vprintf(formato, args);
+        va_end(args);
+        return;
+    }
+    size_t cauda = atomic_load_explicit(&a->cauda, memory_order_relaxed);
+    if (cauda - atomic_load_explicit(&a->cabeca, memory_order_acquire) == REGISTRO_CAPACIDADE) {
+        a->perdidos++;
+        return;
+    }
+    Registro *r = &a->registros[cauda & (REGISTRO_CAPACIDADE - 1)];
+    r->instante_ns = registro_agora_ns() - registro_estado.inicio_ns;
+    r->thread = (uint16_t)registro_id;
+    va_list args;
+    va_start(args, formato);
+    int n = vsnprintf(r->texto, REGISTRO_TEXTO, formato, args);
+    va_end(args);
+    if (n < 0) n = 0;
+    if (n >= REGISTRO_TEXTO) {                       // Truncado: mantém a quebra de linha
+        n = REGISTRO_TEXTO - 1;
+        r->texto[n - 1] = '\n';
+    }
+    r->tamanho = (uint16_t)n;
+    atomic_store_explicit(&a->cauda, cauda + 1, memory_order_release);
+}
+
+static inline void registro_writev(int fd, struct iovec *iov, int n) {
+    while (n > 0) {
+        ssize_t escritos = writev(fd, iov, n);
+        if (escritos < 0) {
+            if (errno == EINTR) continue;
+            return;
+        }
+        while (n > 0 && (size_t)escritos >= iov->iov_len) {    // Escrita parcial: avança os iovecs
+            escritos -= iov->iov_len;
+            iov++;
+            n--;
+        }
+        if (n > 0) {
+            iov->iov_base = (char *)iov->iov_base + escritos;
+            iov->iov_len -= escritos;
+        }
+    }
+}
+
+// Intercala os anéis pelo instante (cada anel já está em ordem) e escreve direto das posições
+// dos anéis, sem cópia. As posições só são liberadas depois da escrita. Chamar com a trava.
+static inline void registro_descarregar_travado(void) {
+    EstadoRegistro *e = &registro_estado;
+    AnelRegistro *aneis[REGISTRO_MAX_THREADS];
+    size_t cabeca[REGISTRO_MAX_THREADS], cauda[REGISTRO_MAX_THREADS];
+    int num = atomic_load(&e->num_aneis), k = 0;
+    for (int i = 0; i < num; i++) {
+        aneis[i] = atomic_load_explicit(&e->aneis[i], memory_order_acquire);
+        if (aneis[i] == NULL) {                              // Reservado, ainda não publicado
+            cabeca[i] = cauda[i] = 0;
+            continue;
+        }
+        cabeca[i] = atomic_load_explicit(&aneis[i]->cabeca, memory_order_relaxed);
+        cauda[i] = atomic_load_explicit(&aneis[i]->cauda, memory_order_acquire);
+    }
+
+    struct iovec iov[REGISTRO_LOTE_IOV];
+    char prefixos[REGISTRO_LOTE_IOV / 2][32];
+    int j = 0;
+    for (;;) {
+        Registro *menor = NULL;
+        for (int i = 0; i < num; i++) {
+            if (cabeca[i] == cauda[i]) continue;
+            Registro *r = &aneis[i]->registros[cabeca[i] & (REGISTRO_CAPACIDADE - 1)];
+            if (menor == NULL || r->instante_ns < menor->instante_ns) {
+                menor = r;
+                k = i;
+            }
+        }
+        if (menor == NULL) break;
+        cabeca[k]++;
+        int p = snprintf(prefixos[j / 2], sizeof(prefixos[0]), "[%11.6f t%02u] ", menor->instante_ns / 1e9,
+                         (unsigned)menor->thread);
+        iov[j].iov_base = prefixos[j / 2];
+        iov[j].iov_len = (size_t)p;
+        iov[j + 1].iov_base = menor->texto;
+        iov[j + 1].iov_len = menor->tamanho;
+        j += 2;
+        if (j == REGISTRO_LOTE_IOV) {
+            registro_writev(e->fd, iov, j);
+            j = 0;
+        }
+    }
+    if (j > 0) registro_writev(e->fd, iov, j);
+    for (int i = 0; i < num; i++) {
+        if (aneis[i] != NULL) atomic_store_explicit(&aneis[i]->cabeca, cauda[i], memory_order_release);
+    }
+}
+
+static inline void *registro_laco_descarga(void *arg) {
+    EstadoRegistro *e = arg;
+    pthread_mutex_lock(&e->trava);
+    while (e->ativo) {
+        struct timespec prazo;
+        clock_gettime(CLOCK_REALTIME, &prazo);
+        long long ns = prazo.tv_nsec + (long long)(e->intervalo * 1e9);
+        prazo.tv_sec += ns / 1000000000LL;
+        prazo.tv_nsec = ns % 1000000000LL;
+        int r = 0;
+        while (e->ativo && r != ETIMEDOUT) r = pthread_cond_timedwait(&e->parar, &e->trava, &prazo);
+        registro_descarregar_travado();
+    }
+    pthread_mutex_unlock(&e->trava);
+    return NULL;
+}
+
+static inline void registro_iniciar(int fd, double intervalo) {
+    EstadoRegistro *e = &registro_estado;
+    if (atomic_load(&registro_geracao) & 1) {
+        fprintf(stderr, "Registro: REGISTRO_INICIAR sem REGISTRO_FINALIZAR da sessão anterior\n");
+        exit(1);
+    }
+    for (int i = 0; i < REGISTRO_MAX_THREADS; i++) atomic_init(&e->aneis[i], NULL);
+    atomic_init(&e->num_aneis, 0);
+    e->fd = fd;
+    e->intervalo = intervalo;
+    e->inicio_ns = registro_agora_ns();
+    e->ativo = 1;
+    pthread_mutex_init(&e->trava, NULL);
+    pthread_cond_init(&e->parar, NULL);
+    if (pthread_create(&e->descarregadora, NULL, registro_laco_descarga, e) != 0) {
+        fprintf(stderr, "Erro ao criar a thread do registro\n");
+        exit(1);
+    }
+    atomic_fetch_add_explicit(&registro_geracao, 1, memory_order_release);   // Publica a sessão
+}
+
+// Descarrega agora; o stdio é esvaziado antes para não inverter a ordem com printf anteriores
+static inline void registro_sincronizar(void) {
+    fflush(stdout);
+    if ((atomic_load(&registro_geracao) & 1) == 0) return;
+    pthread_mutex_lock(&registro_estado.trava);
+    registro_descarregar_travado();
+    pthread_mutex_unlock(&registro_estado.trava);
+}
+
+static inline void registro_finalizar(void) {
+    EstadoRegistro *e = &registro_estado;
+    fflush(stdout);
+    if ((atomic_load(&registro_geracao) & 1) == 0) return;
+    atomic_fetch_add(&registro_geracao, 1);      // Daqui em diante REGISTRAR vira printf
+    pthread_mutex_lock(&e->trava);
+    e->ativo = 0;
+    pthread_cond_signal(&e->parar);
+    pthread_mutex_unlock(&e->trava);
+    pthread_join(e->descarregadora, NULL);       // A última volta do laço descarrega o resto
+
+    size_t perdidos = 0;
+    int num = atomic_load(&e->num_aneis);
+    for (int i = 0; i < num; i++) {
+        AnelRegistro *a = atomic_load(&e->aneis[i]);
+        if (a == NULL) continue;
+        perdidos += a->perdidos;
+        free(a);      // Os ponteiros __thread ficam com a geração antiga e não são mais usados
+    }
+    if (perdidos > 0) fprintf(stderr, "Registro: %zu registros descartados (anel cheio)\n", perdidos);
+    pthread_mutex_destroy(&e->trava);
+    pthread_cond_destroy(&e->parar);
+}
+
+#define REGISTRO_INICIAR(fd, intervalo) registro_iniciar((fd), (intervalo))
+#define REGISTRAR(...) registro_escrever(__VA_ARGS__)
+#define REGISTRO_SINCRONIZAR() registro_sincronizar()
+#define REGISTRO_FINALIZAR() registro_finalizar()
+
+#else // REGISTRO_DESATIVADO
+
+#include <stdio.h>
+#include <unistd.h>
+
+// sizeof não avalia a expressão: nada é executado, mas o formato continua conferido e as
+// variáveis usadas só no registro não geram aviso de "não usada"
+#define REGISTRO_INICIAR(fd, intervalo) ((void)sizeof(fd))
+#define REGISTRAR(...) ((void)sizeof(printf(__VA_ARGS__)))
+#define REGISTRO_SINCRONIZAR() ((void)0)
+#define REGISTRO_FINALIZAR() ((void)0)
+
+#endif // REGISTRO_DESATIVADO
+
+#endif // REGISTRO_H
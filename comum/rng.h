@@ -0,0 +1,180 @@
+#ifndef RNG_H
+#define RNG_H
+
+// Geradores de números aleatórios para Monte Carlo paralelo reprodutível
+//
+// - Philox4x32-10: baseado em contador. O valor i de um fluxo é philox(i, chave),
+//   então qualquer thread calcula qualquer posição sem estado compartilhado.
+// - xoshiro256++: baseado em estado, com jump() = avançar 2^128 passos.
+//   Fluxos obtidos por saltos sucessivos nunca se sobrepõem (período 2^256 - 1).
+// - xorshift64 e PCG32: referências para o teste de qualidade de tarefa8.
+//
+// Para o resultado não depender do número de threads, o trabalho é dividido em
+// blocos fixos e o fluxo é escolhido pelo índice do BLOCO, nunca pelo id da thread.
+
+#include <stdint.h>
+
+// ---------------------------------------------------------------------------
+// splitmix64: usado apenas para expandir uma semente em estado inicial
+// ---------------------------------------------------------------------------
+static inline uint64_t splitmix64(uint64_t *estado) {
+    uint64_t z = (*estado += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+// Conversões para [0, 1): usam apenas os bits altos, sem divisão
+static inline double rng_u64_para_double(uint64_t x) {
+    return (double)(x >> 11) * 0x1.0p-53;
+}
+
+static inline double rng_u32_para_double(uint32_t x) {
+    return (double)x * 0x1.0p-32;
+}
+
+// ---------------------------------------------------------------------------
+// Philox4x32-10 (Salmon et al., "Parallel Random Numbers: As Easy as 1, 2, 3")
+// ---------------------------------------------------------------------------
+typedef struct {
+    uint32_t v[4];
+} Philox4x32;
+
+static inline Philox4x32 philox4x32_10(Philox4x32 ctr, uint32_t k0, uint32_t k1) {
+    for (int r = 0; r < 10; r++) {
+        uint64_t p0 = (uint64_t)0xD2511F53u * ctr.v[0];
+        uint64_t p1 = (uint64_t)0xCD9E8D57u * ctr.v[2];
+        Philox4x32 n;
+        n.v[0] = (uint32_t)(p1 >> 32) ^ ctr.v[1] ^ k0;
+        n.v[1] = (uint32_t)p1;
+        n.v[2] = (uint32_t)(p0 >> 32) ^ ctr.v[3] ^ k1;
+        n.v[3] = (uint32_t)p0;
+        ctr = n;
+        k0 += 0x9E3779B9u;   // Constantes de Weyl para a chave
+        k1 += 0xBB67AE85u;
+    }
+    return ctr;
+}
+
+// Quatro valores de 32 bits da posição 'indice' do fluxo 'semente'
+static inline Philox4x32 philox_gerar(uint64_t semente, uint64_t indice) {
+    Philox4x32 ctr = {{(uint32_t)indice, (uint32_t)(indice >> 32), 0, 0}};
+    return philox4x32_10(ctr, (uint32_t)semente, (uint32_t)(semente >> 32));
+}
+
+// ---------------------------------------------------------------------------
+// xoshiro256++ (Blackman e Vigna)
+// ---------------------------------------------------------------------------
+typedef struct {
+    uint64_t s[4];
+} Xoshiro256;
+
+static inline uint64_t rng_rotl(uint64_t x, int k) {
+    return (x << k) | (x >> (64 - k));
+}
+
+static inline void xoshiro256_semear(Xoshiro256 *g, uint64_t semente) {
+    for (int i = 0; i < 4; i++) g->s[i] = splitmix64(&semente);
+}
+
+static inline uint64_t xoshiro256pp_proximo(Xoshiro256 *g) {
+    uint64_t *s = g->s;
+    uint64_t resultado = rng_rotl(s[0] + s[3], 23) + s[0];
+    uint64_t t = s[1] << 17;
+    s[2] ^= s[0];
+    s[3] ^= s[1];
+    s[1] ^= s[2];
+    s[0] ^= s[3];
+    s[2] ^= t;
+    s[3] = rng_rotl(s[3], 45);
+    return resultado;
+}
+
+// Aplica um polinômio de salto (avança o estado 2^128 ou 2^192 passos)
+static inline void xoshiro256_saltar_poly(Xoshiro256 *g, const uint64_t poly[4]) {
+    uint64_t s0 = 0, s1 = 0, s2 = 0, s3 = 0;
+    for (int i = 0; i < 4; i++) {
+        for (int b = 0; b < 64; b++) {
+            if (poly[i] & (1ULL << b)) {
+                s0 ^= g->s[0];
+                s1 ^= g->s[1];
+                s2 ^= g->s[2];
+                s3 ^= g->s[3];
+            }
+            xoshiro256pp_proximo(g);
+        }
+    }
+    g->s[0] = s0;
+    g->s[1] = s1;
+    g->s[2] = s2;
+    g->s[3] = s3;
+}
+
+// Avança 2^128 passos: até 2^128 fluxos disjuntos de 2^128 valores cada
+static inline void xoshiro256_jump(Xoshiro256 *g) {
+    static const uint64_t JUMP[4] = {0x180ec6d33cfd0abaULL, 0xd5a61266f0c9392cULL,
+                                     0xa9582618e03fc9aaULL, 0x39abdc4529b1661cULL};
+    xoshiro256_saltar_poly(g, JUMP);
+}
+
+// Avança 2^192 passos: separa grupos de fluxos (por exemplo, um por processo MPI)
+static inline void xoshiro256_long_jump(Xoshiro256 *g) {
+    static const uint64_t LONG_JUMP[4] = {0x76e15d3efefdcbbfULL, 0xc5004e441c522fb3ULL,
+                                          0x77710069854ee241ULL, 0x39109bb02acbe635ULL};
+    xoshiro256_saltar_poly(g, LONG_JUMP);
+}
+
+// Fluxos consecutivos: fluxos[b] = semente saltada b vezes (custo O(num_fluxos))
+static inline void xoshiro256_fluxos(Xoshiro256 *fluxos, uint64_t num_fluxos, uint64_t semente) {
+    Xoshiro256 g;
+    xoshiro256_semear(&g, semente);
+    for (uint64_t b = 0; b < num_fluxos; b++) {
+        fluxos[b] = g;
+        xoshiro256_jump(&g);
+    }
+}
+
+// ---------------------------------------------------------------------------
+// Geradores simples, usados como referência de qualidade e velocidade
+// ---------------------------------------------------------------------------
+
+// xorshift64 (Marsaglia, deslocamentos 13, 7, 17): linear em GF(2), estado nunca zero
+typedef struct {
+    uint64_t s;
+} Xorshift64;
+
+static inline void xorshift64_semear(Xorshift64 *g, uint64_t semente) {
+    g->s = splitmix64(&semente) | 1;
+}
+
+static inline uint64_t xorshift64_proximo(Xorshift64 *g) {
+    uint64_t x = g->s;
+    x ^= x << 13;
+    x ^= x >> 7;
+    x ^= x << 17;
+    return g->s = x;
+}
+
+// PCG32 (O'Neill, XSH-RR): LCG de 64 bits com permutação na saída; 'fluxo' escolhe o incremento
+typedef struct {
+    uint64_t estado;
+    uint64_t incremento;   // Sempre ímpar
+} Pcg32;
+
+static inline uint32_t pcg32_proximo(Pcg32 *g) {
+    uint64_t antigo = g->estado;
+    g->estado = antigo * 6364136223846793005ULL + g->incremento;
+    uint32_t xorshifted = (uint32_t)(((antigo >> 18) ^ antigo) >> 27);
+    uint32_t rot = (uint32_t)(antigo >> 59);
+    return (xorshifted >> rot) | (xorshifted << ((32 - rot) & 31));
+}
+
+static inline void pcg32_semear(Pcg32 *g, uint64_t semente, uint64_t fluxo) {
+    g->estado = 0;
+    g->incremento = (fluxo << 1) | 1;
+    pcg32_proximo(g);
+    g->estado += semente;
+    pcg32_proximo(g);
+}
+
+#endif // RNG_H
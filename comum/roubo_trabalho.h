@@ -0,0 +1,412 @@
+#ifndef ROUBO_TRABALHO_H
+#define ROUBO_TRABALHO_H
+
+// Runtime de tarefas com roubo de trabalho (work stealing)
+//
+// - Um deque de Chase-Lev por trabalhador (versão C11 de Lê et al., 2013):
+//   o dono empilha e desempilha na base (LIFO, sem CAS no caso comum);
+//   os ladrões retiram do topo (as tarefas mais antigas, em geral as maiores) com um CAS
+// - Vítima aleatória: cada trabalhador sem tarefas sorteia outro e tenta roubar
+// - Qualquer tarefa pode criar tarefas: não existe um único produtor como no 'omp single'
+// - Fork-join por grupos: rt_spawn incrementa o contador do grupo; rt_esperar executa ou
+//   rouba tarefas até o contador chegar a zero
+//
+// API: rt_iniciar / rt_executar / rt_finalizar, rt_spawn / rt_esperar,
+//      rt_paralelo_for (divisão binária) e rt_percorrer_lista (lista encadeada)
+
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdatomic.h>
+#include <pthread.h>
+#include <sched.h>
+
+#define RT_DEQUE_INICIAL 256      // Itens; dobra quando enche
+#define RT_LINHA 128
+#define RT_LOTE_LISTA 32          // Nós percorridos por tarefa caminhante
+#define RT_FALHAS_ATE_YIELD 64
+
+typedef void (*rt_funcao)(void *a, void *b);
+
+typedef struct {
+    atomic_long pendentes;
+} RtGrupo;
+
+// Campos atômicos (relaxados): um ladrão pode ler um item enquanto o dono o sobrescreve;
+// o CAS no topo decide depois se a leitura vale
+typedef struct {
+    _Atomic(rt_funcao) f;
+    _Atomic(void *) a;
+    _Atomic(void *) b;
+    _Atomic(RtGrupo *) grupo;
+} RtItem;
+
+typedef struct RtVetor {
+    long tamanho;                 // Potência de 2
+    struct RtVetor *anterior;     // Vetores substituídos: liberados só no rt_finalizar
+    RtItem itens[];
+} RtVetor;
+
+typedef struct {
+    _Alignas(RT_LINHA) atomic_long topo;     // Escrito pelos ladrões
+    _Alignas(RT_LINHA) atomic_long base;     // Escrito só pelo dono
+    _Atomic(RtVetor *) vetor;
+    uint32_t semente;                        // Sorteio de vítimas
+    long executadas;                         // Estatísticas (só o dono escreve)
+    long roubadas;
+} RtTrabalhador;
+
+typedef struct Runtime {
+    int num_trabalhadores;
+    RtTrabalhador *trabalhadores;
+    pthread_t *threads;
+    pthread_mutex_t trava;
+    pthread_cond_t acordar;
+    int epoca;                    // Incrementada a cada rt_executar (protegida por trava)
+    int encerrar;
+    atomic_int ativo;             // 1 enquanto rt_executar roda: os trabalhadores procuram tarefas
+} Runtime;
+
+typedef struct {
+    Runtime *rt;
+    int id;
+} RtArgThread;
+
+static __thread Runtime *rt_atual = NULL;
+static __thread int rt_id_atual = -1;
+
+// ---------------------------------------------------------------------------
+// Deque de Chase-Lev
+// ---------------------------------------------------------------------------
+static inline RtVetor *rt_vetor_novo(long tamanho) {
+    RtVetor *v = malloc(sizeof(RtVetor) + tamanho * sizeof(RtItem));
+    if (v == NULL) {
+        fprintf(stderr, "Erro ao alocar memória para o deque\n");
+        exit(1);
+    }
+    v->tamanho = tamanho;
+    v->anterior = NULL;
+    return v;
+}
+
+static inline void rt_item_escrever(RtItem *it, rt_funcao f, void *a, void *b, RtGrupo *g) {
+    atomic_store_explicit(&it->f, f, memory_order_relaxed);
+    atomic_store_explicit(&it->a, a, memory_order_relaxed);
+    atomic_store_explicit(&it->b, b, memory_order_relaxed);
+    atomic_store_explicit(&it->grupo, g, memory_order_relaxed);
+}
+
+static inline void rt_item_ler(RtItem *it, RtItem *destino) {
+    rt_item_escrever(destino, atomic_load_explicit(&it->f, memory_order_relaxed),
+                     atomic_load_explicit(&it->a, memory_order_relaxed),
+                     atomic_load_explicit(&it->b, memory_order_relaxed),
+                     atomic_load_explicit(&it->grupo, memory_order_relaxed));
+}
+
+// Dono: empilha na base
+static inline void rt_deque_empilhar(RtTrabalhador *w, rt_funcao f, void *a, void *b, RtGrupo *g) {
+    long base = atomic_load_explicit(&w->base, memory_order_relaxed);
+    long topo = atomic_load_explicit(&w->topo, memory_order_acquire);
+    RtVetor *v = atomic_load_explicit(&w->vetor, memory_order_relaxed);
+    if (base - topo > v->tamanho - 1) {       // Cheio: copia para um vetor com o dobro
+        RtVetor *novo = rt_vetor_novo(v->tamanho * 2);
+        for (long i = topo; i < base; i++) {
+            RtItem tmp;
+            rt_item_ler(&v->itens[i & (v->tamanho - 1)], &tmp);
+            novo->itens[i & (novo->tamanho - 1)] = tmp;
+        }
+        novo->anterior = v;
+        atomic_store_explicit(&w->vetor, novo, memory_order_release);
+        v = novo;
+    }
+    rt_item_escrever(&v->itens[base & (v->tamanho - 1)], f, a, b, g);
+    atomic_thread_fence(memory_order_release);
+    atomic_store_explicit(&w->base, base + 1, memory_order_relaxed);
+}
+
+// Dono: desempilha da base; só disputa (CAS) quando resta um único item
+static inline int rt_deque_desempilhar(RtTrabalhador *w, RtItem *saida) {
+    long base = atomic_load_explicit(&w->base, memory_order_relaxed) - 1;
+    RtVetor *v = atomic_load_explicit(&w->vetor, memory_order_relaxed);
+    atomic_store_explicit(&w->base, base, memory_order_relaxed);
+    atomic_thread_fence(memory_order_seq_cst);
+    long topo = atomic_load_explicit(&w->topo, memory_order_relaxed);
+    if (topo > base) {                         // Vazio
+        atomic_store_explicit(&w->base, base + 1, memory_order_relaxed);
+        return 0;
+    }
+    rt_item_ler(&v->itens[base & (v->tamanho - 1)], saida);
+    if (topo == base) {                        // Último item: disputa com os ladrões
+        int ganhou = atomic_compare_exchange_strong_explicit(&w->topo, &topo, topo + 1,
+                                                             memory_order_seq_cst, memory_order_relaxed);
+        atomic_store_explicit(&w->base, base + 1, memory_order_relaxed);
+        return ganhou;
+    }
+    return 1;
+}
+
+// Ladrão: retira do topo
+static inline int rt_deque_roubar(RtTrabalhador *w, RtItem *saida) {
+    long topo = atomic_load_explicit(&w->topo, memory_order_acquire);
+    atomic_thread_fence(memory_order_seq_cst);
+    long base = atomic_load_explicit(&w->base, memory_order_acquire);
+    if (topo >= base) return 0;
+    RtVetor *v = atomic_load_explicit(&w->vetor, memory_order_acquire);
+    rt_item_ler(&v->itens[topo & (v->tamanho - 1)], saida);
+    return atomic_compare_exchange_strong_explicit(&w->topo, &topo, topo + 1,
+                                                   memory_order_seq_cst, memory_order_relaxed);
+}
+
+// ---------------------------------------------------------------------------
+// Execução
+// ---------------------------------------------------------------------------
+static inline uint32_t rt_sortear(RtTrabalhador *w) {
+    uint32_t x = w->semente;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    return w->semente = x;
+}
+
+static inline void rt_rodar(RtTrabalhador *w, RtItem *it) {
+    rt_funcao f = atomic_load_explicit(&it->f, memory_order_relaxed);
+    RtGrupo *g = atomic_load_explicit(&it->grupo, memory_order_relaxed);
+    f(atomic_load_explicit(&it->a, memory_order_relaxed), atomic_load_explicit(&it->b, memory_order_relaxed));
+    w->executadas++;
+    atomic_fetch_sub_explicit(&g->pendentes, 1, memory_order_release);
+}
+
+// Executa uma tarefa: primeiro a do próprio deque, depois tenta roubar de vítimas aleatórias
+static inline int rt_executar_uma(Runtime *rt, int id) {
+    RtTrabalhador *w = &rt->trabalhadores[id];
+    RtItem it;
+    if (rt_deque_desempilhar(w, &it)) {
+        rt_rodar(w, &it);
+        return 1;
+    }
+    int n = rt->num_trabalhadores;
+    for (int tentativa = 0; tentativa < n; tentativa++) {
+        int vitima = (int)(rt_sortear(w) % (uint32_t)n);
+        if (vitima == id) continue;
+        if (rt_deque_roubar(&rt->trabalhadores[vitima], &it)) {
+            w->roubadas++;
+            rt_rodar(w, &it);
+            return 1;
+        }
+    }
+    return 0;
+}
+
+static inline void rt_pausa(int *falhas) {
+    if (++*falhas < RT_FALHAS_ATE_YIELD) {
+#if defined(__x86_64__) || defined(__i386__)
+        __builtin_ia32_pause();
+#endif
+    } else {
+        sched_yield();
+        *falhas = 0;
+    }
+}
+
+static inline void *rt_laco_trabalhador(void *p) {
+    RtArgThread *arg = p;
+    Runtime *rt = arg->rt;
+    rt_atual = rt;
+    rt_id_atual = arg->id;
+    free(arg);
+
+    int epoca_vista = 0;
+    for (;;) {
+        pthread_mutex_lock(&rt->trava);
+        while (rt->epoca == epoca_vista && !rt->encerrar) pthread_cond_wait(&rt->acordar, &rt->trava);
+        if (rt->encerrar) {
+            pthread_mutex_unlock(&rt->trava);
+            break;
+        }
+        epoca_vista = rt->epoca;
+        pthread_mutex_unlock(&rt->trava);
+
+        int falhas = 0;
+        while (atomic_load_explicit(&rt->ativo, memory_order_acquire)) {
+            if (rt_executar_uma(rt, rt_id_atual)) falhas = 0;
+            else rt_pausa(&falhas);
+        }
+    }
+    return NULL;
+}
+
+static inline void rt_grupo_iniciar(RtGrupo *g) {
+    atomic_init(&g->pendentes, 0);
+}
+
+// Cria uma tarefa f(a, b) no deque do trabalhador atual (chamar dentro de rt_executar)
+static inline void rt_spawn(RtGrupo *g, rt_funcao f, void *a, void *b) {
+    atomic_fetch_add_explicit(&g->pendentes, 1, memory_order_relaxed);
+    rt_deque_empilhar(&rt_atual->trabalhadores[rt_id_atual], f, a, b, g);
+}
+
+// Espera as tarefas do grupo, executando ou roubando outras enquanto isso
+static inline void rt_esperar(RtGrupo *g) {
+    int falhas = 0;
+    while (atomic_load_explicit(&g->pendentes, memory_order_acquire) > 0) {
+        if (rt_executar_uma(rt_atual, rt_id_atual)) falhas = 0;
+        else rt_pausa(&falhas);
+    }
+}
+
+// Cria num_trabalhadores - 1 threads; a thread que chama rt_executar é o trabalhador 0
+static inline void rt_iniciar(Runtime *rt, int num_trabalhadores) {
+    if (num_trabalhadores < 1) num_trabalhadores = 1;
+    rt->num_trabalhadores = num_trabalhadores;
+    if (posix_memalign((void **)&rt->trabalhadores, RT_LINHA, num_trabalhadores * sizeof(RtTrabalhador)) != 0) {
+        fprintf(stderr, "Erro ao alocar memória para os trabalhadores\n");
+        exit(1);
+    }
+    for (int i = 0; i < num_trabalhadores; i++) {
+        RtTrabalhador *w = &rt->trabalhadores[i];
+        atomic_init(&w->topo, 0);
+        atomic_init(&w->base, 0);
+        atomic_init(&w->vetor, rt_vetor_novo(RT_DEQUE_INICIAL));
+        w->semente = 0x9E3779B9u * (i + 1);
+        w->executadas = 0;
+        w->roubadas = 0;
+    }
+    pthread_mutex_init(&rt->trava, NULL);
+    pthread_cond_init(&rt->acordar, NULL);
+    rt->epoca = 0;
+    rt->encerrar = 0;
+    atomic_init(&rt->ativo, 0);
+    rt->threads = malloc(num_trabalhadores * sizeof(pthread_t));
+    if (rt->threads == NULL) {
+        fprintf(stderr, "Erro ao alocar memória para as threads\n");
+        exit(1);
+    }
+    for (int i = 1; i < num_trabalhadores; i++) {
+        RtArgThread *arg = malloc(sizeof(RtArgThread));
+        if (arg == NULL) {
+            fprintf(stderr, "Erro ao alocar memória para as threads\n");
+            exit(1);
+        }
+        arg->rt = rt;
+        arg->id = i;
+        if (pthread_create(&rt->threads[i], NULL, rt_laco_trabalhador, arg) != 0) {
+            fprintf(stderr, "Erro ao criar trabalhador %d\n", i);
+            exit(1);
+        }
+    }
+}
+
+// Executa raiz(arg) como trabalhador 0. A raiz deve esperar (rt_esperar) tudo o que criou.
+static inline void rt_executar(Runtime *rt, void (*raiz)(void *), void *arg) {
+    rt_atual = rt;
+    rt_id_atual = 0;
+    atomic_store_explicit(&rt->ativo, 1, memory_order_release);
+    pthread_mutex_lock(&rt->trava);
+    rt->epoca++;
+    pthread_cond_broadcast(&rt->acordar);
+    pthread_mutex_unlock(&rt->trava);
+
+    raiz(arg);
+
+    atomic_store_explicit(&rt->ativo, 0, memory_order_release);
+}
+
+static inline void rt_finalizar(Runtime *rt) {
+    pthread_mutex_lock(&rt->trava);
+    rt->encerrar = 1;
+    pthread_cond_broadcast(&rt->acordar);
+    pthread_mutex_unlock(&rt->trava);
+    for (int i = 1; i < rt->num_trabalhadores; i++) pthread_join(rt->threads[i], NULL);
+    for (int i = 0; i < rt->num_trabalhadores; i++) {
+        RtVetor *v = atomic_load(&rt->trabalhadores[i].vetor);
+        while (v != NULL) {
+            RtVetor *ant = v->anterior;
+            free(v);
+            v = ant;
+        }
+    }
+    free(rt->trabalhadores);
+    free(rt->threads);
+    pthread_mutex_destroy(&rt->trava);
+    pthread_cond_destroy(&rt->acordar);
+}
+
+// ---------------------------------------------------------------------------
+// Laço paralelo: divide [inicio, fim) ao meio até 'grao' iterações; a metade de cima vira
+// tarefa (e pode ser roubada), a de baixo é processada na hora
+// ---------------------------------------------------------------------------
+typedef void (*rt_corpo_for)(long inicio, long fim, void *arg);
+
+typedef struct {
+    long inicio, fim, grao;
+    rt_corpo_for corpo;
+    void *arg;
+} RtFor;
+
+static inline void rt_for_recursivo(void *p, void *nao_usado) {
+    (void)nao_usado;
+    RtFor *r = p;
+    if (r->fim - r->inicio <= r->grao) {
+        r->corpo(r->inicio, r->fim, r->arg);
+        return;
+    }
+    long meio = r->inicio + (r->fim - r->inicio) / 2;
+    RtFor cima = *r, baixo = *r;   // Na pilha: vivos até o rt_esperar abaixo
+    cima.inicio = meio;
+    baixo.fim = meio;
+    RtGrupo g;
+    rt_grupo_iniciar(&g);
+    rt_spawn(&g, rt_for_recursivo, &cima, NULL);
+    rt_for_recursivo(&baixo, NULL);
+    rt_esperar(&g);
+}
+
+static inline void rt_paralelo_for(long inicio, long fim, long grao, rt_corpo_for corpo, void *arg) {
+    RtFor r = {inicio, fim, grao > 0 ? grao : 1, corpo, arg};
+    rt_for_recursivo(&r, NULL);
+}
+
+// ---------------------------------------------------------------------------
+// Percurso de lista encadeada: uma tarefa "caminhante" anda RT_LOTE_LISTA nós, cria primeiro
+// a caminhante do restante da lista (a mais antiga no deque: é a que os ladrões levam) e
+// depois uma tarefa por nó. Assim a criação de tarefas se espalha pelos trabalhadores.
+// ---------------------------------------------------------------------------
+typedef void *(*rt_proximo_fn)(void *no);
+typedef void (*rt_corpo_no)(void *no, void *arg);
+
+typedef struct {
+    rt_proximo_fn proximo;
+    rt_corpo_no corpo;
+    void *arg;
+    RtGrupo grupo;
+} RtLista;
+
+static inline void rt_lista_no(void *no, void *ctx) {
+    RtLista *l = ctx;
+    l->corpo(no, l->arg);
+}
+
+static inline void rt_lista_caminhar(void *no, void *ctx) {
+    RtLista *l = ctx;
+    void *lote[RT_LOTE_LISTA];
+    int n = 0;
+    while (no != NULL && n < RT_LOTE_LISTA) {
+        lote[n++] = no;
+        no = l->proximo(no);
+    }
+    if (no != NULL) rt_spawn(&l->grupo, rt_lista_caminhar, no, l);
+    for (int i = 0; i < n; i++) rt_spawn(&l->grupo, rt_lista_no, lote[i], l);
+}
+
+static inline void rt_percorrer_lista(void *cabeca, rt_proximo_fn proximo, rt_corpo_no corpo, void *arg) {
+    RtLista l;
+    l.proximo = proximo;
+    l.corpo = corpo;
+    l.arg = arg;
+    rt_grupo_iniciar(&l.grupo);
+    if (cabeca != NULL) rt_spawn(&l.grupo, rt_lista_caminhar, cabeca, &l);
+    rt_esperar(&l.grupo);
+}
+
+#endif // ROUBO_TRABALHO_H
@@ -0,0 +1,135 @@
+#ifndef TELEMETRIA_H
+#define TELEMETRIA_H
+
+// Telemetria de progresso para laços paralelos longos, com custo desprezível no laço
+//
+// - Cada thread conta no próprio registrador e, a cada TELEMETRIA_K iterações, publica o
+//   total com um store relaxado em um slot só seu (128 bytes: sem falso compartilhamento)
+// - Uma thread relatora (pthread) acorda a cada 'intervalo' segundos, soma os slots com
+//   loads relaxados e imprime progresso e vazão; as threads de cálculo nunca esperam por ela
+//
+// Uso:
+//   Telemetria tel;
+//   telemetria_iniciar(&tel, "nome", total, omp_get_max_threads(), 0.5);
+//   #pragma omp parallel { ... TELEMETRIA_PASSO(&tel, tid, feitos); ... telemetria_publicar(&tel, tid, feitos); }
+//   telemetria_finalizar(&tel);
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdatomic.h>
+#include <pthread.h>
+#include <time.h>
+#include <errno.h>
+#include <omp.h>
+
+#define TELEMETRIA_K 4096          // Iterações entre publicações (potência de 2)
+#define TELEMETRIA_LINHA 128
+
+typedef struct {
+    _Alignas(TELEMETRIA_LINHA) atomic_llong feitos;
+    char preenchimento[TELEMETRIA_LINHA - sizeof(atomic_llong)];
+} SlotTelemetria;
+
+typedef struct {
+    SlotTelemetria *slots;
+    int num_slots;
+    const char *nome;
+    long long total;           // Trabalho esperado (para o percentual)
+    double intervalo;          // Segundos entre amostras
+    double inicio;
+    int amostras;              // Linhas impressas pela relatora
+    int ativa;                 // Protegida por trava
+    pthread_mutex_t trava;
+    pthread_cond_t parar;      // Acorda a relatora antes do fim do intervalo
+    pthread_t relatora;
+} Telemetria;
+
+// Soma relaxada dos slots: pode estar até K iterações por thread atrasada
+static inline long long telemetria_ler(Telemetria *t) {
+    long long soma = 0;
+    for (int i = 0; i < t->num_slots; i++) {
+        soma += atomic_load_explicit(&t->slots[i].feitos, memory_order_relaxed);
+    }
+    return soma;
+}
+
+// Publica o total feito pela thread até agora (só a dona escreve no slot)
+static inline void telemetria_publicar(Telemetria *t, int tid, long long feitos) {
+    atomic_store_explicit(&t->slots[tid].feitos, feitos, memory_order_relaxed);
+}
+
+// Chamada a cada iteração: publica só quando 'feitos' é múltiplo de TELEMETRIA_K
+#define TELEMETRIA_PASSO(t, tid, feitos) \
+    do { if (((feitos) & (TELEMETRIA_K - 1)) == 0) telemetria_publicar((t), (tid), (feitos)); } while (0)
+
+static inline void *telemetria_relatora(void *arg) {
+    Telemetria *t = arg;
+    long long anterior = 0;
+    double t_anterior = t->inicio;
+
+    pthread_mutex_lock(&t->trava);
+    while (t->ativa) {
+        struct timespec prazo;
+        clock_gettime(CLOCK_REALTIME, &prazo);
+        long long ns = prazo.tv_nsec + (long long)(t->intervalo * 1e9);
+        prazo.tv_sec += ns / 1000000000LL;
+        prazo.tv_nsec = ns % 1000000000LL;
+        int r = 0;
+        while (t->ativa && r != ETIMEDOUT) r = pthread_cond_timedwait(&t->parar, &t->trava, &prazo);
+        if (!t->ativa) break;
+
+        long long feitos = telemetria_ler(t);
+        double agora = omp_get_wtime();
+        if (t->nome != NULL) {     // nome NULL: amostra sem imprimir (medição de sobrecarga)
+            printf("  [%s] %5.1f%% | %.1f Mitens/s (desde o início: %.1f)\n", t->nome,
+                   100.0 * feitos / t->total, (feitos - anterior) / (agora - t_anterior) / 1e6,
+                   feitos / (agora - t->inicio) / 1e6);
+            fflush(stdout);
+        }
+        t->amostras++;
+        anterior = feitos;
+        t_anterior = agora;
+    }
+    pthread_mutex_unlock(&t->trava);
+    return NULL;
+}
+
+static inline void telemetria_iniciar(Telemetria *t, const char *nome, long long total,
+                                      int num_threads, double intervalo) {
+    if (posix_memalign((void **)&t->slots, TELEMETRIA_LINHA, num_threads * sizeof(SlotTelemetria)) != 0) {
+        fprintf(stderr, "Erro ao alocar memória para a telemetria\n");
+        exit(1);
+    }
+    for (int i = 0; i < num_threads; i++) atomic_init(&t->slots[i].feitos, 0);
+    t->num_slots = num_threads;
+    t->nome = nome;
+    t->total = total > 0 ? total : 1;
+    t->intervalo = intervalo;
+    t->inicio = omp_get_wtime();
+    t->amostras = 0;
+    t->ativa = 1;
+    pthread_mutex_init(&t->trava, NULL);
+    pthread_cond_init(&t->parar, NULL);
+    if (pthread_create(&t->relatora, NULL, telemetria_relatora, t) != 0) {
+        fprintf(stderr, "Erro ao criar a thread relatora\n");
+        exit(1);
+    }
+}
+
+// Para a relatora e devolve o total publicado (exato se cada thread publicou ao terminar)
+static inline long long telemetria_finalizar(Telemetria *t) {
+    pthread_mutex_lock(&t->trava);
+    t->ativa = 0;
+    pthread_cond_signal(&t->parar);
+    pthread_mutex_unlock(&t->trava);
+    pthread_join(t->relatora, NULL);
+
+    long long feitos = telemetria_ler(t);
+    pthread_mutex_destroy(&t->trava);
+    pthread_cond_destroy(&t->parar);
+    free(t->slots);
+    t->slots = NULL;
+    return feitos;
+}
+
+#endif // TELEMETRIA_H
@@ -2,6 +2,14 @@
 #include <stdlib.h>
 #include <omp.h>
 #include <time.h>
+#include "../comum/rng.h"
+#include "../comum/contador_fragmentado.h"
+#include "../comum/mc_simd.h"
+#include "../comum/estatisticas.h"
+
+#define PONTOS_POR_BLOCO 65536 // Blocos do kernel SIMD (um fluxo por lane em cada bloco)
+
+#define SEMENTE 2024 // Semente fixa: o resultado não depende do número de threads
 
 int main(int argc, char *argv[]) {
     long long int N = 100000000; // Número de pontos para Monte Carlo
@@ -70,8 +78,8 @@ int main(int argc, char *argv[]) {
     printf("Versao 3 (privado):  pi = %.10f | Tempo: %.5f s\n", pi, end-start);
 
     // 4. Vetor de contadores privados
-    long long int *acertos_vet = malloc(nthreads * sizeof(long long int)); // Array para resultados
-    for (int i = 0; i < nthreads; i++) acertos_vet[i] = 0;
+    ContadorFragmentado acertos_vet; // Um fragmento por thread, cada um em linha de cache própria
+    contador_criar(&acertos_vet, nthreads);
     start = omp_get_wtime();
     #pragma omp parallel num_threads(nthreads)
     {
@@ -84,14 +92,13 @@ int main(int argc, char *argv[]) {
             double y = (double)rand_r(&seed) / RAND_MAX;
             if (x*x + y*y <= 1.0) local++;
         }
-        acertos_vet[tid] = local; // Cada thread escreve em posição única - zero contenção
+        contador_somar(contador_preparar_local(&acertos_vet, tid), local); // Fragmento próprio - zero contenção
     }
-    long long int acertos_total = 0;
-    for (int i = 0; i < nthreads; i++) acertos_total += acertos_vet[i]; // Redução sequencial
+    long long int acertos_total = contador_coletar(&acertos_vet); // Coleta exata após a região paralela
     pi = 4.0 * (double)acertos_total / (double)N;
     end = omp_get_wtime();
     printf("Versao 4 (vetor):    pi = %.10f | Tempo: %.5f s\n", pi, end-start);
-    free(acertos_vet);
+    contador_destruir(&acertos_vet);
 
     // 5. Reduction
     long long int acertos_reduction = 0;
@@ -108,7 +115,62 @@ int main(int argc, char *argv[]) {
     }
     pi = 4.0 * (double)acertos_reduction / (double)N;
     end = omp_get_wtime();
+    double tempo_reduction = end - start; // Referência para a vazão do kernel SIMD
     printf("Versao 5 (reduction):pi = %.10f | Tempo: %.5f s\n", pi, end-start);
 
+    // 6. Reduction + Philox4x32-10 (gerador por contador: reprodutível)
+    long long int acertos_philox = 0;
+    start = omp_get_wtime();
+    #pragma omp parallel for num_threads(nthreads) reduction(+:acertos_philox)
+    for (long long int j = 0; j < (N + 1) / 2; j++) {
+        Philox4x32 r = philox_gerar(SEMENTE, (uint64_t)j); // Par j -> contador j, em qualquer thread
+        double x = rng_u32_para_double(r.v[0]);
+        double y = rng_u32_para_double(r.v[1]);
+        if (x*x + y*y <= 1.0) acertos_philox++;
+        if (2 * j + 1 < N) { // Segundo ponto do par
+            x = rng_u32_para_double(r.v[2]);
+            y = rng_u32_para_double(r.v[3]);
+            if (x*x + y*y <= 1.0) acertos_philox++;
+        }
+    }
+    pi = 4.0 * (double)acertos_philox / (double)N;
+    end = omp_get_wtime();
+    printf("Versao 6 (philox):   pi = %.10f | Tempo: %.5f s\n", pi, end-start);
+
+    // 7. Reduction + kernel SIMD, para cada conjunto de instruções disponível
+    printf("\nVazao por thread (Mpontos/s): reduction = %.1f\n", N / tempo_reduction / nthreads / 1e6);
+    long long int num_blocos = (N + PONTOS_POR_BLOCO - 1) / PONTOS_POR_BLOCO;
+    for (int isa = MC_ISA_ESCALAR; isa <= mc_simd_isa_detectada(); isa++) {
+        mc_kernel_fn kernel = mc_simd_kernel(isa); // Seleção em tempo de execução
+        long long int acertos_simd = 0;
+        start = omp_get_wtime();
+        #pragma omp parallel for num_threads(nthreads) schedule(static) reduction(+:acertos_simd)
+        for (long long int b = 0; b < num_blocos; b++) {
+            long long int tamanho = (b + 1) * PONTOS_POR_BLOCO <= N ? PONTOS_POR_BLOCO : N - b * PONTOS_POR_BLOCO;
+            acertos_simd += kernel(SEMENTE, (uint64_t)b, tamanho);
+        }
+        pi = 4.0 * (double)acertos_simd / (double)N;
+        end = omp_get_wtime();
+        printf("Versao 7 (%-18s): pi = %.10f | Tempo: %.5f s | %.1f Mpontos/s por thread\n",
+               mc_simd_nome(isa), pi, end-start, N / (end - start) / nthreads / 1e6);
+    }
+
+    // 8. Reduction com estatísticas completas (declare reduction): π e erro-padrão na mesma passada
+    Estatisticas estat = est_vazia();
+    start = omp_get_wtime();
+    #pragma omp parallel num_threads(nthreads) reduction(estat:estat)
+    {
+        unsigned int seed = (unsigned int)time(NULL) ^ omp_get_thread_num();
+        #pragma omp for
+        for (long long int i = 0; i < N; i++) {
+            double x = (double)rand_r(&seed) / RAND_MAX;
+            double y = (double)rand_r(&seed) / RAND_MAX;
+            est_adicionar(&estat, 4.0 * (x*x + y*y <= 1.0)); // f = 4 * indicador
+        }
+    }
+    end = omp_get_wtime();
+    printf("\nVersao 8 (estat.):   pi = %.10f | Tempo: %.5f s | erro-padrao = %.2e | min = %.0f | max = %.0f\n",
+           est_media(&estat), end-start, est_erro_padrao(&estat), estat.min, estat.max);
+
     return 0;
 }
@@ -0,0 +1,99 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <omp.h>
+#include "../comum/contador_fragmentado.h"
+
+#define MAX_THREADS 256
+
+#define MEC_CRITICAL 0
+#define MEC_ATOMIC 1
+#define MEC_VETOR 2        // long long vet[tid]: vizinhos na mesma linha de cache (falso compartilhamento)
+#define MEC_FRAGMENTADO 3  // ContadorFragmentado: um fragmento por linha de cache, página local
+#define MEC_REDUCTION 4
+#define NUM_MECANISMOS 5
+
+const char *nomes[NUM_MECANISMOS] = {"critical", "atomic", "vetor compacto", "fragmentado", "reduction"};
+
+// Cada thread faz M incrementos no contador com o mecanismo escolhido; devolve o tempo
+double medir(int mecanismo, int nthreads, long long int M, long long int *total) {
+    long long int contador = 0;
+    volatile long long int vet[MAX_THREADS] = {0}; // volatile: força um store por incremento
+    ContadorFragmentado frag;
+    contador_criar(&frag, nthreads);
+
+    double start = omp_get_wtime();
+    #pragma omp parallel num_threads(nthreads)
+    {
+        int tid = omp_get_thread_num();
+        switch (mecanismo) {
+        case MEC_CRITICAL:
+            for (long long int i = 0; i < M; i++) {
+                #pragma omp critical
+                contador++;
+            }
+            break;
+        case MEC_ATOMIC:
+            for (long long int i = 0; i < M; i++) {
+                #pragma omp atomic
+                contador++;
+            }
+            break;
+        case MEC_VETOR:
+            for (long long int i = 0; i < M; i++) vet[tid]++;
+            #pragma omp atomic
+            contador += vet[tid];
+            break;
+        case MEC_FRAGMENTADO: {
+            FragmentoContador *meu = contador_preparar_local(&frag, tid);
+            for (long long int i = 0; i < M; i++) contador_somar(meu, 1);
+            break;
+        }
+        }
+    }
+    if (mecanismo == MEC_REDUCTION) {
+        #pragma omp parallel for num_threads(nthreads) schedule(static) reduction(+:contador)
+        for (long long int i = 0; i < M * nthreads; i++) {
+            contador++;
+            __asm__ volatile("" : "+r"(contador)); // Impede o compilador de somar o laço em forma fechada
+        }
+    }
+    double tempo = omp_get_wtime() - start;
+
+    if (mecanismo == MEC_FRAGMENTADO) contador = contador_coletar(&frag);
+    contador_destruir(&frag);
+    *total = contador;
+    return tempo;
+}
+
+int main(int argc, char *argv[]) {
+    long long int M = 10000000; // Incrementos por thread
+    int max_threads = omp_get_num_procs();
+    if (argc > 1) M = atoll(argv[1]);
+    if (argc > 2) max_threads = atoi(argv[2]);
+    if (max_threads > MAX_THREADS) max_threads = MAX_THREADS;
+
+    printf("Contenção em um contador: cada thread faz %lld incrementos (1 a %d threads)\n", M, max_threads);
+    printf("ns/incremento = tempo total / incrementos de todas as threads (quanto menor, melhor)\n\n");
+    printf("%-8s %-16s %-14s %-12s %-10s\n", "Threads", "Mecanismo", "Tempo (s)", "ns/incr", "Mops/s");
+
+    for (int t = 1; ; t = (t * 2 < max_threads) ? t * 2 : max_threads) { // 1, 2, 4, ..., todos
+        // critical serializa tudo: usa menos incrementos para não dominar o tempo total
+        for (int m = 0; m < NUM_MECANISMOS; m++) {
+            long long int Mm = (m == MEC_CRITICAL) ? M / 10 : M;
+            long long int total;
+            double tempo = medir(m, t, Mm, &total);
+            long long int esperado = Mm * t;
+            if (total != esperado) {
+                printf("Erro: %s com %d threads contou %lld (esperado %lld)\n", nomes[m], t, total, esperado);
+            }
+            printf("%-8d %-16s %-14.4f %-12.3f %-10.1f\n", t, nomes[m], tempo,
+                   tempo * 1e9 / esperado, esperado / tempo / 1e6);
+        }
+        printf("\n");
+        if (t == max_threads) break;
+    }
+
+    return 0;
+}
+
+// Compilação: gcc -O2 -fopenmp tarefa10_contencao.c -o tarefa10_contencao
@@ -0,0 +1,159 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <mpi.h>
+#include <omp.h>
+#include "../comum/rng.h"
+
+#define PONTOS_POR_BLOCO 65536  // Um fluxo (jump de 2^128) por bloco dentro do rank
+#define SEMENTE 2024
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+#define MODO_FRACO 0  // Weak scaling: N pontos POR RANK
+#define MODO_FORTE 1  // Strong scaling: N pontos no TOTAL, divididos entre os ranks
+
+// Fluxos do rank: o rank r parte de long_jump^r (2^192 números de distância entre ranks)
+// e cada bloco local avança mais um jump (2^128) a partir daí
+Xoshiro256 *fluxos_do_rank(int rank, long long int num_blocos) {
+    Xoshiro256 *fluxos = malloc(num_blocos * sizeof(Xoshiro256));
+    if (fluxos == NULL) {
+        fprintf(stderr, "Rank %d: erro ao alocar memória para os fluxos\n", rank);
+        MPI_Abort(MPI_COMM_WORLD, 1);
+    }
+    Xoshiro256 g;
+    xoshiro256_semear(&g, SEMENTE);
+    for (int r = 0; r < rank; r++) xoshiro256_long_jump(&g);
+    for (long long int b = 0; b < num_blocos; b++) {
+        fluxos[b] = g;
+        xoshiro256_jump(&g);
+    }
+    return fluxos;
+}
+
+// Kernel OpenMP (reduction) sobre os blocos [inicio, fim) do rank
+long long int contar_blocos(Xoshiro256 *fluxos, long long int inicio, long long int fim) {
+    long long int acertos = 0;
+    #pragma omp parallel for schedule(static) reduction(+:acertos)
+    for (long long int b = inicio; b < fim; b++) {
+        Xoshiro256 g = fluxos[b];
+        for (int i = 0; i < PONTOS_POR_BLOCO; i++) {
+            double x = rng_u64_para_double(xoshiro256pp_proximo(&g));
+            double y = rng_u64_para_double(xoshiro256pp_proximo(&g));
+            acertos += (x*x + y*y <= 1.0);
+        }
+    }
+    return acertos;
+}
+
+int main(int argc, char *argv[]) {
+    int nivel, rank, size;
+    MPI_Init_thread(&argc, &argv, MPI_THREAD_FUNNELED, &nivel); // Só a thread mestre chama MPI
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+    MPI_Comm_size(MPI_COMM_WORLD, &size);
+
+    int modo = MODO_FRACO;
+    long long int N = 100000000;
+    int rodadas = 8; // O Iallreduce da rodada r corre enquanto a rodada r+1 é calculada
+    if (argc > 1) modo = strcmp(argv[1], "forte") == 0 ? MODO_FORTE : MODO_FRACO;
+    if (argc > 2) N = atoll(argv[2]);
+    if (argc > 3) rodadas = atoi(argv[3]);
+    if (rodadas < 1) rodadas = 1;
+
+    // Cada rank precisa de pelo menos um bloco inteiro (senão π e a vazão saem de 0/0)
+    long long int minimo = modo == MODO_FRACO ? PONTOS_POR_BLOCO : (long long int)PONTOS_POR_BLOCO * size;
+    if (N < minimo) {
+        if (rank == 0) {
+            fprintf(stderr, "N = %lld é pequeno demais: o modo %s precisa de N >= %lld (%d pontos por bloco, %d ranks)\n",
+                    N, modo == MODO_FRACO ? "fraco" : "forte", minimo, PONTOS_POR_BLOCO, size);
+        }
+        MPI_Finalize();
+        return 1;
+    }
+
+    if (nivel < MPI_THREAD_FUNNELED && rank == 0) {
+        printf("Aviso: a biblioteca MPI não garante MPI_THREAD_FUNNELED\n");
+    }
+
+    // Divisão dos blocos: no modo forte o total é fixo e o resto vai para os primeiros ranks
+    long long int blocos_locais;
+    if (modo == MODO_FRACO) {
+        blocos_locais = N / PONTOS_POR_BLOCO;
+    } else {
+        long long int total = N / PONTOS_POR_BLOCO;
+        blocos_locais = total / size + (rank < total % size ? 1 : 0);
+    }
+    Xoshiro256 *fluxos = fluxos_do_rank(rank, blocos_locais);
+
+    long long int local[2] = {0, 0};   // {acertos, pontos} acumulados no rank
+    long long int enviado[2];          // Buffer do Iallreduce em andamento: não pode ser alterado
+    long long int global[2] = {0, 0};
+    MPI_Request req = MPI_REQUEST_NULL;
+    double tempo_espera = 0.0;
+
+    if (rank == 0) {
+        printf("\n====================================================\n");
+        printf("     MONTE CARLO HIBRIDO MPI + OPENMP\n");
+        printf("====================================================\n");
+        printf("Modo:                    %s\n", modo == MODO_FRACO ? "fraco (N por rank)" : "forte (N total)");
+        printf("Ranks x threads:         %d x %d\n", size, omp_get_max_threads());
+        printf("Rodadas:                 %d\n", rodadas);
+        printf("----------------------------------------------------\n");
+    }
+
+    MPI_Barrier(MPI_COMM_WORLD);
+    double start = MPI_Wtime();
+
+    for (int r = 0; r < rodadas; r++) {
+        long long int inicio = blocos_locais * r / rodadas;
+        long long int fim = blocos_locais * (r + 1) / rodadas;
+        local[0] += contar_blocos(fluxos, inicio, fim);
+        local[1] += (fim - inicio) * PONTOS_POR_BLOCO;
+
+        // Conclui a redução anterior (já deve ter progredido durante o cálculo) e inicia a nova
+        double t0 = MPI_Wtime();
+        MPI_Wait(&req, MPI_STATUS_IGNORE);
+        if (r > 0 && rank == 0 && global[1] > 0) {
+            printf("  rodada %d: π parcial = %.10f (%lld pontos)\n", r, 4.0 * global[0] / global[1], global[1]);
+        }
+        enviado[0] = local[0];
+        enviado[1] = local[1];
+        MPI_Iallreduce(enviado, global, 2, MPI_LONG_LONG, MPI_SUM, MPI_COMM_WORLD, &req);
+        tempo_espera += MPI_Wtime() - t0;
+    }
+    double t0 = MPI_Wtime();
+    MPI_Wait(&req, MPI_STATUS_IGNORE);
+    tempo_espera += MPI_Wtime() - t0;
+
+    double tempo = MPI_Wtime() - start;
+    free(fluxos);
+
+    // Vazão por rank: mínimo, média e máximo entre os ranks
+    double taxa = local[1] / tempo / 1e6;
+    double taxa_min, taxa_max, taxa_soma, tempo_max, espera_max;
+    MPI_Reduce(&taxa, &taxa_min, 1, MPI_DOUBLE, MPI_MIN, 0, MPI_COMM_WORLD);
+    MPI_Reduce(&taxa, &taxa_max, 1, MPI_DOUBLE, MPI_MAX, 0, MPI_COMM_WORLD);
+    MPI_Reduce(&taxa, &taxa_soma, 1, MPI_DOUBLE, MPI_SUM, 0, MPI_COMM_WORLD);
+    MPI_Reduce(&tempo, &tempo_max, 1, MPI_DOUBLE, MPI_MAX, 0, MPI_COMM_WORLD);
+    MPI_Reduce(&tempo_espera, &espera_max, 1, MPI_DOUBLE, MPI_MAX, 0, MPI_COMM_WORLD);
+
+    if (rank == 0) {
+        double pi = 4.0 * global[0] / global[1];
+        printf("----------------------------------------------------\n");
+        printf("Pontos totais:           %lld\n", global[1]);
+        printf("pi:                      %.10f (erro %.2e)\n", pi, pi > M_PI ? pi - M_PI : M_PI - pi);
+        printf("Tempo (max entre ranks): %.4f s\n", tempo_max);
+        printf("Espera MPI_Wait (max):   %.6f s\n", espera_max);
+        printf("Mpontos/s por rank:      min %.1f | media %.1f | max %.1f\n", taxa_min, taxa_soma / size, taxa_max);
+        printf("Mpontos/s agregado:      %.1f\n", global[1] / tempo_max / 1e6);
+        printf("====================================================\n");
+    }
+
+    MPI_Finalize();
+    return 0;
+}
+
+// Compilação: mpicc -O2 -fopenmp tarefa10_hibrido.c -o tarefa10_hibrido
+// Execução:   OMP_NUM_THREADS=2 mpirun -np 2 ./tarefa10_hibrido [fraco|forte] [N] [rodadas]
@@ -0,0 +1,153 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <time.h>
+#include <omp.h>
+#include "../comum/mc_integracao.h"
+
+#define SEMENTE 2024
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+// ---------------------------------------------------------------------------
+// Integrandos: versão escalar e versão em lote (SoA, laço interno vetorizável)
+// ---------------------------------------------------------------------------
+
+// π como caso particular: 4 * [x² + y² <= 1] em [0, 1]²
+double pi_escalar(const double *x, int d, void *dados) {
+    (void)d; (void)dados;
+    return 4.0 * (x[0]*x[0] + x[1]*x[1] <= 1.0);
+}
+
+void pi_lote(const double *x, int d, int n, double *saida, void *dados) {
+    (void)d; (void)dados;
+    const double *xs = x, *ys = x + n;
+    #pragma omp simd
+    for (int i = 0; i < n; i++) saida[i] = 4.0 * (xs[i]*xs[i] + ys[i]*ys[i] <= 1.0);
+}
+
+// Indicador da bola unitária em [-1, 1]^d: volume exato π^(d/2) / Γ(d/2 + 1)
+double bola_escalar(const double *x, int d, void *dados) {
+    (void)dados;
+    double r2 = 0.0;
+    for (int k = 0; k < d; k++) r2 += x[k] * x[k];
+    return r2 <= 1.0;
+}
+
+void bola_lote(const double *x, int d, int n, double *saida, void *dados) {
+    (void)dados;
+    #pragma omp simd
+    for (int i = 0; i < n; i++) saida[i] = 0.0;
+    for (int k = 0; k < d; k++) {
+        const double *xk = x + (long)k * n;
+        #pragma omp simd
+        for (int i = 0; i < n; i++) saida[i] += xk[i] * xk[i];
+    }
+    #pragma omp simd
+    for (int i = 0; i < n; i++) saida[i] = saida[i] <= 1.0;
+}
+
+// Gaussiana separável Π exp(-x_k²) em [0, 1]^d: exato (√π/2 · erf(1))^d
+double gauss_escalar(const double *x, int d, void *dados) {
+    (void)dados;
+    double s = 0.0;
+    for (int k = 0; k < d; k++) s += x[k] * x[k];
+    return exp(-s);
+}
+
+void gauss_lote(const double *x, int d, int n, double *saida, void *dados) {
+    (void)dados;
+    #pragma omp simd
+    for (int i = 0; i < n; i++) saida[i] = 0.0;
+    for (int k = 0; k < d; k++) {
+        const double *xk = x + (long)k * n;
+        #pragma omp simd
+        for (int i = 0; i < n; i++) saida[i] += xk[i] * xk[i];
+    }
+    for (int i = 0; i < n; i++) saida[i] = exp(-saida[i]);
+}
+
+// ---------------------------------------------------------------------------
+// Referência: Versao 5 (reduction) de tarefa10.c, com rand_r
+// ---------------------------------------------------------------------------
+double pi_reduction(long long int N, int nthreads, double *tempo) {
+    long long int acertos_reduction = 0;
+    double start = omp_get_wtime();
+    #pragma omp parallel num_threads(nthreads) reduction(+:acertos_reduction)
+    {
+        unsigned int seed = (unsigned int)time(NULL) ^ omp_get_thread_num();
+        #pragma omp for
+        for (long long int i = 0; i < N; i++) {
+            double x = (double)rand_r(&seed) / RAND_MAX;
+            double y = (double)rand_r(&seed) / RAND_MAX;
+            if (x*x + y*y <= 1.0) acertos_reduction++;
+        }
+    }
+    *tempo = omp_get_wtime() - start;
+    return 4.0 * (double)acertos_reduction / (double)N;
+}
+
+void imprimir(const char *nome, int d, MCResultado r, double exato) {
+    char desvios[32];
+    snprintf(desvios, sizeof(desvios), "%.2f", fabs(r.integral - exato) / r.erro_padrao);
+    printf("%-24s %-4d %-15.10f %-15.10f %-11.3e %-9s %-10.4f %-10.1f\n", nome, d, r.integral, exato,
+           r.erro_padrao, desvios, r.tempo, r.amostras / r.tempo / 1e6);
+}
+
+int main(int argc, char *argv[]) {
+    long long int N = 100000000; // Pontos para π
+    int nthreads = 4;
+    if (argc > 1) N = atoll(argv[1]);
+    if (argc > 2) nthreads = atoi(argv[2]);
+
+    printf("Integração de Monte Carlo genérica: %lld pontos, %d threads\n", N, nthreads);
+    printf("Desvios = |estimativa - exato| / erro-padrão (deve ficar quase sempre abaixo de 3)\n\n");
+    printf("%-24s %-4s %-15s %-15s %-11s %-9s %-10s %-10s\n",
+           "Integrando", "d", "Estimativa", "Exato", "Erro-padrao", "Desvios", "Tempo (s)", "Mpontos/s");
+
+    // π: referência de tarefa10 e o motor genérico (escalar e em lote)
+    double tempo_ref;
+    double pi_ref = pi_reduction(N, nthreads, &tempo_ref);
+    printf("%-24s %-4d %-15.10f %-15.10f %-11s %-9s %-10.4f %-10.1f\n", "pi reduction (tarefa10)", 2,
+           pi_ref, M_PI, "-", "-", tempo_ref, N / tempo_ref / 1e6);
+
+    MCDominio quadrado = mc_dominio_cubo(2, 0.0, 1.0);
+    MCIntegrando pi_f = {pi_escalar, NULL, NULL};
+    MCIntegrando pi_l = {pi_escalar, pi_lote, NULL};
+    imprimir("pi motor (escalar)", 2, mc_integrar(&pi_f, &quadrado, N, SEMENTE, nthreads), M_PI);
+    imprimir("pi motor (lote)", 2, mc_integrar(&pi_l, &quadrado, N, SEMENTE, nthreads), M_PI);
+
+    // Bola unitária: a fração da caixa ocupada cai rápido com d
+    int dims_bola[] = {3, 5, 10};
+    for (int i = 0; i < 3; i++) {
+        int d = dims_bola[i];
+        MCDominio cubo = mc_dominio_cubo(d, -1.0, 1.0);
+        MCIntegrando bola = {bola_escalar, bola_lote, NULL};
+        double exato = pow(M_PI, d / 2.0) / tgamma(d / 2.0 + 1.0);
+        imprimir("volume da bola (lote)", d, mc_integrar(&bola, &cubo, N / 4, SEMENTE, nthreads), exato);
+    }
+
+    // Gaussiana em dimensão alta
+    int dims_gauss[] = {5, 20};
+    for (int i = 0; i < 2; i++) {
+        int d = dims_gauss[i];
+        MCDominio cubo = mc_dominio_cubo(d, 0.0, 1.0);
+        MCIntegrando gf = {gauss_escalar, NULL, NULL};
+        MCIntegrando gl = {gauss_escalar, gauss_lote, NULL};
+        double exato = pow(sqrt(M_PI) / 2.0 * erf(1.0), d);
+        imprimir("gaussiana (escalar)", d, mc_integrar(&gf, &cubo, N / 8, SEMENTE, nthreads), exato);
+        imprimir("gaussiana (lote)", d, mc_integrar(&gl, &cubo, N / 8, SEMENTE, nthreads), exato);
+    }
+
+    // Mesmo resultado com qualquer número de threads (blocos combinados em ordem)
+    MCResultado um = mc_integrar(&pi_l, &quadrado, N / 10, SEMENTE, 1);
+    MCResultado todos = mc_integrar(&pi_l, &quadrado, N / 10, SEMENTE, nthreads);
+    printf("\nReprodutibilidade: 1 thread = %.15f | %d threads = %.15f (%s)\n", um.integral, nthreads,
+           todos.integral, um.integral == todos.integral ? "idênticos" : "diferentes");
+
+    return 0;
+}
+
+// Compilação: gcc -O2 -fopenmp tarefa10_integracao.c -o tarefa10_integracao -lm
@@ -0,0 +1,146 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <omp.h>
+#include "../comum/rng.h"
+#include "../comum/qmc.h"
+
+#define PONTOS_POR_BLOCO 65536 // Cada bloco salta direto para seu índice na sequência
+#define MAX_REPLICAS 64
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+// Pseudo-aleatório (referência): Philox, 2 pontos por contador
+long long int contar_prng(long long int N, uint64_t semente, int nthreads) {
+    long long int acertos = 0;
+    #pragma omp parallel for num_threads(nthreads) reduction(+:acertos)
+    for (long long int j = 0; j < (N + 1) / 2; j++) {
+        Philox4x32 r = philox_gerar(semente, (uint64_t)j);
+        double x = rng_u32_para_double(r.v[0]);
+        double y = rng_u32_para_double(r.v[1]);
+        if (x*x + y*y <= 1.0) acertos++;
+        if (2 * j + 1 < N) {
+            x = rng_u32_para_double(r.v[2]);
+            y = rng_u32_para_double(r.v[3]);
+            if (x*x + y*y <= 1.0) acertos++;
+        }
+    }
+    return acertos;
+}
+
+// Sobol com deslocamento digital (XOR) aleatório: cada thread começa no próprio bloco
+long long int contar_sobol(const Sobol2D *sobol, long long int N, uint32_t desl_x, uint32_t desl_y, int nthreads) {
+    long long int acertos = 0;
+    long long int num_blocos = (N + PONTOS_POR_BLOCO - 1) / PONTOS_POR_BLOCO;
+    #pragma omp parallel for num_threads(nthreads) schedule(static) reduction(+:acertos)
+    for (long long int b = 0; b < num_blocos; b++) {
+        long long int inicio = b * PONTOS_POR_BLOCO;
+        long long int fim = inicio + PONTOS_POR_BLOCO < N ? inicio + PONTOS_POR_BLOCO : N;
+        uint32_t a, c;
+        sobol2d_ponto(sobol, (uint64_t)inicio, &a, &c); // Skip-ahead até o início do bloco
+        for (long long int i = inicio; i < fim; i++) {
+            double x = ((a ^ desl_x) + 0.5) * 0x1.0p-32;
+            double y = ((c ^ desl_y) + 0.5) * 0x1.0p-32;
+            if (x*x + y*y <= 1.0) acertos++;
+            sobol2d_avancar(sobol, (uint64_t)i, &a, &c); // Um XOR por coordenada
+        }
+    }
+    return acertos;
+}
+
+// Halton (bases 2 e 3) com rotação de Cranley-Patterson: x -> frac(x + u)
+long long int contar_halton(long long int N, double rot_x, double rot_y, int nthreads) {
+    long long int acertos = 0;
+    long long int num_blocos = (N + PONTOS_POR_BLOCO - 1) / PONTOS_POR_BLOCO;
+    #pragma omp parallel for num_threads(nthreads) schedule(static) reduction(+:acertos)
+    for (long long int b = 0; b < num_blocos; b++) {
+        long long int inicio = b * PONTOS_POR_BLOCO;
+        long long int fim = inicio + PONTOS_POR_BLOCO < N ? inicio + PONTOS_POR_BLOCO : N;
+        Halton hx, hy;
+        halton_init(&hx, 2, (uint64_t)inicio + 1); // Índice 0 é (0, 0) nas duas bases: pula
+        halton_init(&hy, 3, (uint64_t)inicio + 1);
+        for (long long int i = inicio; i < fim; i++) {
+            double x = halton_valor(&hx) + rot_x;
+            double y = halton_valor(&hy) + rot_y;
+            if (x >= 1.0) x -= 1.0;
+            if (y >= 1.0) y -= 1.0;
+            if (x*x + y*y <= 1.0) acertos++;
+            halton_avancar(&hx);
+            halton_avancar(&hy);
+        }
+    }
+    return acertos;
+}
+
+// Erro quadrático médio em relação a π e erro-padrão estimado pelas réplicas
+void estatisticas(const double *estimativas, int R, double *rmse, double *erro_padrao) {
+    double media = 0.0, eqm = 0.0, var = 0.0;
+    for (int r = 0; r < R; r++) {
+        media += estimativas[r];
+        eqm += (estimativas[r] - M_PI) * (estimativas[r] - M_PI);
+    }
+    media /= R;
+    for (int r = 0; r < R; r++) var += (estimativas[r] - media) * (estimativas[r] - media);
+    *rmse = sqrt(eqm / R);
+    *erro_padrao = sqrt(var / (R - 1)) / sqrt((double)R); // Erro da média das réplicas
+}
+
+int main(int argc, char *argv[]) {
+    long long int N_max = 10000000; // Maior número de pontos da tabela
+    int nthreads = 4;
+    int R = 8;                      // Réplicas aleatorizadas por método
+    if (argc > 1) N_max = atoll(argv[1]);
+    if (argc > 2) nthreads = atoi(argv[2]);
+    if (argc > 3) R = atoi(argv[3]);
+    if (R < 2) R = 2;
+    if (R > MAX_REPLICAS) R = MAX_REPLICAS;
+
+    Sobol2D sobol;
+    sobol2d_init(&sobol);
+
+    printf("Quasi-Monte Carlo vs pseudo-aleatório: %d réplicas por método, %d threads\n", R, nthreads);
+    printf("RMSE = raiz do erro quadrático médio das réplicas em relação a π\n");
+    printf("EP   = erro-padrão estimado só a partir da dispersão das réplicas (sem conhecer π)\n\n");
+    printf("%-11s | %-10s | %-10s %-10s | %-10s %-10s | %-14s\n",
+           "N", "RMSE PRNG", "RMSE Sobol", "EP Sobol", "RMSE Halt.", "EP Halt.", "PRNG equiv.");
+
+    double est_prng[MAX_REPLICAS], est_sobol[MAX_REPLICAS], est_halton[MAX_REPLICAS];
+    double tempo_prng = 0.0, tempo_sobol = 0.0, tempo_halton = 0.0;
+
+    for (long long int N = 1000; N <= N_max; N *= 10) {
+        for (int r = 0; r < R; r++) {
+            uint64_t semente = 1000 + r;
+            uint64_t estado = semente; // Aleatorização independente por réplica
+            uint64_t u = splitmix64(&estado);
+
+            double start = omp_get_wtime();
+            est_prng[r] = 4.0 * contar_prng(N, semente, nthreads) / N;
+            double meio = omp_get_wtime();
+            est_sobol[r] = 4.0 * contar_sobol(&sobol, N, (uint32_t)u, (uint32_t)(u >> 32), nthreads) / N;
+            double fim = omp_get_wtime();
+            est_halton[r] = 4.0 * contar_halton(N, rng_u64_para_double(splitmix64(&estado)),
+                                                rng_u64_para_double(splitmix64(&estado)), nthreads) / N;
+            tempo_prng += meio - start;
+            tempo_sobol += fim - meio;
+            tempo_halton += omp_get_wtime() - fim;
+        }
+
+        double rmse_prng, ep_prng, rmse_sobol, ep_sobol, rmse_halton, ep_halton;
+        estatisticas(est_prng, R, &rmse_prng, &ep_prng);
+        estatisticas(est_sobol, R, &rmse_sobol, &ep_sobol);
+        estatisticas(est_halton, R, &rmse_halton, &ep_halton);
+
+        // Pontos pseudo-aleatórios necessários para o mesmo erro do Sobol (erro ~ 1/sqrt(N))
+        double equivalente = N * (rmse_prng / rmse_sobol) * (rmse_prng / rmse_sobol);
+
+        printf("%-11lld | %-10.2e | %-10.2e %-10.2e | %-10.2e %-10.2e | %-14.3e\n",
+               N, rmse_prng, rmse_sobol, ep_sobol, rmse_halton, ep_halton, equivalente);
+    }
+
+    printf("\nTempo total: PRNG %.3f s | Sobol %.3f s | Halton %.3f s\n", tempo_prng, tempo_sobol, tempo_halton);
+    return 0;
+}
+
+// Compilação: gcc -O2 -fopenmp tarefa10_qmc.c -o tarefa10_qmc -lm
@@ -0,0 +1,208 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <omp.h>
+#include "../comum/rng.h"
+
+#define PONTOS_POR_BLOCO 65536  // Um fluxo xoshiro256++ (jump) por bloco
+#define AMOSTRAS_POR_ESTRATO 4  // Necessário >= 2 para estimar a variância dentro do estrato
+#define SEMENTE 2024
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+// Resultado de um estimador: variância POR AMOSTRA = N * Var(estimativa)
+typedef struct {
+    double pi;
+    double variancia;   // Menor variância -> menos amostras para o mesmo erro
+    long long int amostras;
+    double tempo;
+} Estimativa;
+
+// Fluxos disjuntos para 'num' blocos (ou linhas de estratos)
+Xoshiro256 *criar_fluxos(long long int num) {
+    Xoshiro256 *fluxos = malloc(num * sizeof(Xoshiro256));
+    if (fluxos == NULL) {
+        fprintf(stderr, "Erro ao alocar memória para os fluxos\n");
+        exit(1);
+    }
+    xoshiro256_fluxos(fluxos, num, SEMENTE);
+    return fluxos;
+}
+
+// Fecha uma estimativa a partir das somas de f e f² (média e variância em uma passada)
+Estimativa fechar(double soma, double soma_q, long long int n, double tempo) {
+    Estimativa e;
+    e.pi = soma / n;
+    e.variancia = soma_q / n - e.pi * e.pi;
+    e.amostras = n;
+    e.tempo = tempo;
+    return e;
+}
+
+// 1. Acerto ou erro (referência de tarefa6/8/10): f = 4 * [x² + y² <= 1]
+Estimativa acerto_ou_erro(long long int N, int nthreads) {
+    long long int num_blocos = N / PONTOS_POR_BLOCO;
+    Xoshiro256 *fluxos = criar_fluxos(num_blocos);
+    long long int acertos = 0;
+    double start = omp_get_wtime();
+    #pragma omp parallel for num_threads(nthreads) schedule(static) reduction(+:acertos)
+    for (long long int b = 0; b < num_blocos; b++) {
+        Xoshiro256 g = fluxos[b];
+        for (int i = 0; i < PONTOS_POR_BLOCO; i++) {
+            double x = rng_u64_para_double(xoshiro256pp_proximo(&g));
+            double y = rng_u64_para_double(xoshiro256pp_proximo(&g));
+            acertos += (x*x + y*y <= 1.0);
+        }
+    }
+    double tempo = omp_get_wtime() - start;
+    free(fluxos);
+    long long int n = num_blocos * PONTOS_POR_BLOCO;
+    return fechar(4.0 * acertos, 16.0 * acertos, n, tempo); // f² = 16 * indicador
+}
+
+// 2. Amostragem estratificada: grade K x K, AMOSTRAS_POR_ESTRATO pontos por célula.
+//    Cada thread processa linhas inteiras da grade com seu próprio fluxo por linha.
+Estimativa estratificada(long long int N, int nthreads) {
+    long long int K = (long long int)sqrt((double)N / AMOSTRAS_POR_ESTRATO);
+    Xoshiro256 *fluxos = criar_fluxos(K);
+    double soma = 0.0, soma_var = 0.0; // soma_var = Σ variância amostral de cada estrato
+    double start = omp_get_wtime();
+    #pragma omp parallel for num_threads(nthreads) schedule(static) reduction(+:soma, soma_var)
+    for (long long int a = 0; a < K; a++) {
+        Xoshiro256 g = fluxos[a];
+        for (long long int b = 0; b < K; b++) {
+            int dentro = 0;
+            for (int k = 0; k < AMOSTRAS_POR_ESTRATO; k++) {
+                double x = (a + rng_u64_para_double(xoshiro256pp_proximo(&g))) / K;
+                double y = (b + rng_u64_para_double(xoshiro256pp_proximo(&g))) / K;
+                dentro += (x*x + y*y <= 1.0);
+            }
+            // Estrato inteiro dentro ou fora do círculo: variância zero, sem custo extra
+            double p = (double)dentro / AMOSTRAS_POR_ESTRATO;
+            soma += 4.0 * p;
+            soma_var += 16.0 * p * (1.0 - p) * AMOSTRAS_POR_ESTRATO / (AMOSTRAS_POR_ESTRATO - 1);
+        }
+    }
+    double tempo = omp_get_wtime() - start;
+    free(fluxos);
+
+    // π = média dos estratos; Var = (1/S²) Σ σ²_s / m; por amostra: multiplica por N = S m
+    double S = (double)K * K;
+    Estimativa e;
+    e.pi = soma / S;
+    e.amostras = K * K * AMOSTRAS_POR_ESTRATO;
+    e.variancia = soma_var / (S * S * AMOSTRAS_POR_ESTRATO) * e.amostras;
+    e.tempo = tempo;
+    return e;
+}
+
+// 3. Pares antitéticos: (x, y) e (1-x, 1-y). O indicador é monótono, então os pares
+//    são negativamente correlacionados. A variância é medida sobre a média do par.
+Estimativa antitetica(long long int N, int nthreads) {
+    long long int num_blocos = N / PONTOS_POR_BLOCO;
+    Xoshiro256 *fluxos = criar_fluxos(num_blocos);
+    double soma = 0.0, soma_q = 0.0;
+    double start = omp_get_wtime();
+    #pragma omp parallel for num_threads(nthreads) schedule(static) reduction(+:soma, soma_q)
+    for (long long int b = 0; b < num_blocos; b++) {
+        Xoshiro256 g = fluxos[b];
+        for (int i = 0; i < PONTOS_POR_BLOCO / 2; i++) {
+            double x = rng_u64_para_double(xoshiro256pp_proximo(&g));
+            double y = rng_u64_para_double(xoshiro256pp_proximo(&g));
+            double x2 = 1.0 - x, y2 = 1.0 - y;
+            double par = 2.0 * ((x*x + y*y <= 1.0) + (x2*x2 + y2*y2 <= 1.0)); // Média do par
+            soma += par;
+            soma_q += par * par;
+        }
+    }
+    double tempo = omp_get_wtime() - start;
+    free(fluxos);
+    long long int pares = num_blocos * (PONTOS_POR_BLOCO / 2);
+    Estimativa e = fechar(soma, soma_q, pares, tempo);
+    e.variancia *= 2.0; // Cada par consome 2 amostras
+    e.amostras = 2 * pares;
+    return e;
+}
+
+// 4. Integração 1D: π = 4 ∫ sqrt(1 - x²) dx em [0, 1], com controle c(x) = 4 (1 - x²),
+//    cuja média exata é 8/3. Estimador: média(f) - β (média(c) - 8/3), β = Cov(f,c) / Var(c).
+//    Todas as somas necessárias (f, c, f², c², fc) são acumuladas na mesma passada.
+Estimativa integracao_controle(long long int N, int nthreads, int usar_controle, Estimativa *sem_controle) {
+    long long int num_blocos = N / PONTOS_POR_BLOCO;
+    Xoshiro256 *fluxos = criar_fluxos(num_blocos);
+    double sf = 0.0, sc = 0.0, sff = 0.0, scc = 0.0, sfc = 0.0;
+    double start = omp_get_wtime();
+    #pragma omp parallel for num_threads(nthreads) schedule(static) reduction(+:sf, sc, sff, scc, sfc)
+    for (long long int b = 0; b < num_blocos; b++) {
+        Xoshiro256 g = fluxos[b];
+        for (int i = 0; i < PONTOS_POR_BLOCO; i++) {
+            double x = rng_u64_para_double(xoshiro256pp_proximo(&g));
+            double f = 4.0 * sqrt(1.0 - x*x);
+            double c = 4.0 * (1.0 - x*x);
+            sf += f;
+            sff += f * f;
+            if (usar_controle) {
+                sc += c;
+                scc += c * c;
+                sfc += f * c;
+            }
+        }
+    }
+    double tempo = omp_get_wtime() - start;
+    free(fluxos);
+    long long int n = num_blocos * PONTOS_POR_BLOCO;
+
+    Estimativa e = fechar(sf, sff, n, tempo);
+    if (sem_controle != NULL) *sem_controle = e;
+    if (!usar_controle) return e;
+
+    double mf = sf / n, mc = sc / n;
+    double var_c = scc / n - mc * mc;
+    double cov = sfc / n - mf * mc;
+    double beta = cov / var_c;
+    e.pi = mf - beta * (mc - 8.0 / 3.0);
+    e.variancia = e.variancia - cov * cov / var_c; // Var(f - βc) com β ótimo
+    return e;
+}
+
+void imprimir(const char *nome, Estimativa e, double var_ref) {
+    double taxa = e.amostras / e.tempo;
+    printf("%-26s %-13.10f %-10.2e %-11.4e %-9.1f %-11.1f %-12.1f\n", nome, e.pi, fabs(e.pi - M_PI),
+           e.variancia, var_ref / e.variancia, taxa / 1e6, taxa * (var_ref / e.variancia) / 1e6);
+}
+
+int main(int argc, char *argv[]) {
+    long long int N = 100000000; // Amostras por estimador
+    int nthreads = 4;
+    if (argc > 1) N = atoll(argv[1]);
+    if (argc > 2) nthreads = atoi(argv[2]);
+    if (N < 1) {
+        fprintf(stderr, "N precisa ser positivo\n");
+        return 1;
+    }
+    // Os estimadores trabalham em blocos inteiros: arredonda N para cima (pelo menos um bloco)
+    N = (N + PONTOS_POR_BLOCO - 1) / PONTOS_POR_BLOCO * PONTOS_POR_BLOCO;
+
+    printf("Redução de variância para Monte Carlo de π: N = %lld, %d threads\n", N, nthreads);
+    printf("Var/amostra: N * Var(estimativa). Redução: Var(acerto ou erro) / Var(método)\n");
+    printf("Efetivo: amostras/s * redução = pontos de acerto-ou-erro por segundo com o mesmo erro\n\n");
+    printf("%-26s %-13s %-10s %-11s %-9s %-11s %-12s\n",
+           "Metodo", "pi", "Erro", "Var/amostra", "Reducao", "Mamostras/s", "Efetivo M/s");
+
+    Estimativa ref = acerto_ou_erro(N, nthreads);
+    imprimir("Acerto ou erro", ref, ref.variancia);
+    imprimir("Estratificada (grade)", estratificada(N, nthreads), ref.variancia);
+    imprimir("Antitetica", antitetica(N, nthreads), ref.variancia);
+
+    Estimativa integral;
+    Estimativa controle = integracao_controle(N, nthreads, 1, &integral);
+    integral.tempo = integracao_controle(N, nthreads, 0, NULL).tempo; // Tempo sem as somas do controle
+    imprimir("Integracao 1D", integral, ref.variancia);
+    imprimir("Integracao 1D + controle", controle, ref.variancia);
+
+    return 0;
+}
+
+// Compilação: gcc -O2 -fopenmp tarefa10_variancia.c -o tarefa10_variancia -lm
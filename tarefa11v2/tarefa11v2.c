@@ -3,6 +3,7 @@
 #include <math.h>
 #include <omp.h>
 #include <string.h>
+#include "../comum/estatisticas.h"
 
 // Parâmetros da simulação
 #define NX 256      // Número de pontos na direção x
@@ -96,18 +97,21 @@ double calculate_divergence(VelocityField *field) {
     return max_div;
 }
 
-// Função para calcular a energia cinética total
-double calculate_kinetic_energy(VelocityField *field) {
-    double energy = 0.0;
+// Função para calcular a energia cinética média por célula
+// Se 'diag' não for NULL, devolve também desvio, mínimo e máximo da energia por célula,
+// calculados na mesma passada pela redução 'estat' (sem percorrer o campo de novo)
+double calculate_kinetic_energy(VelocityField *field, Estatisticas *diag) {
+    Estatisticas energy = est_vazia();
     
-    #pragma omp parallel for collapse(2) reduction(+:energy)
+    #pragma omp parallel for collapse(2) reduction(estat:energy)
     for (int i = 0; i < NX; i++) {
         for (int j = 0; j < NY; j++) {
-            energy += field->u[i][j] * field->u[i][j] + field->v[i][j] * field->v[i][j];
+            est_adicionar(&energy, 0.5 * (field->u[i][j] * field->u[i][j] + field->v[i][j] * field->v[i][j]));
         }
     }
     
-    return 0.5 * energy / (NX * NY);
+    if (diag != NULL) *diag = energy;
+    return est_media(&energy);
 }
 
 // Função para evoluir o campo de velocidade usando diferenças finitas
@@ -237,10 +241,11 @@ void run_simulation(int mode, const char *schedule_type, int num_threads) {
         
         // Calcular e imprimir estatísticas a cada 250 iterações
         if (iter % 250 == 0) {
-            double energy = calculate_kinetic_energy(current);
+            Estatisticas diag;
+            double energy = calculate_kinetic_energy(current, &diag);
             double divergence = calculate_divergence(current);
-            printf("Iteração %d: Energia = %.6f, Divergência máx = %.6e\n", 
-                   iter, energy, divergence);
+            printf("Iteração %d: Energia = %.6f (desvio %.3e, máx %.6f), Divergência máx = %.6e\n", 
+                   iter, energy, est_desvio(&diag), diag.max, divergence);
         }
         
         // Salvar campo a cada 500 iterações
@@ -257,7 +262,7 @@ void run_simulation(int mode, const char *schedule_type, int num_threads) {
     printf("Tempo de execução: %.4f segundos\n", elapsed_time);
     
     // Estatísticas finais
-    double final_energy = calculate_kinetic_energy(current);
+    double final_energy = calculate_kinetic_energy(current, NULL);
     double final_divergence = calculate_divergence(current);
     printf("Energia final: %.6f\n", final_energy);
     printf("Divergência final máxima: %.6e\n", final_divergence);
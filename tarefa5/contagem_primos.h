@@ -0,0 +1,87 @@
+#ifndef CONTAGEM_PRIMOS_H
+#define CONTAGEM_PRIMOS_H
+
+// Contagem de primos pi(x) em tempo sublinear - algoritmo de Lucy_Hedgehog
+// Custo O(x^(3/4)) operações e O(sqrt(x)) memória, contra O(x sqrt(x)) da divisão por tentativa
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <math.h>
+#include <omp.h>
+
+// Raiz quadrada inteira exata (corrige o arredondamento de sqrt em double)
+static inline int64_t raiz_inteira(int64_t x) {
+    int64_t r = (int64_t)sqrt((double)x);
+    while (r * r > x) r--;
+    while ((r + 1) * (r + 1) <= x) r++;
+    return r;
+}
+
+// S(v) = quantidade de inteiros em [2, v] que sobrevivem ao crivo pelos primos já processados.
+// Só interessam os valores v = x / i, que são no máximo 2*sqrt(x) distintos:
+//   pequenos[v]  guarda S(v)     para v <= r
+//   grandes[i]   guarda S(x / i) para i <= r
+// Para cada primo p <= r: S(v) -= S(v / p) - S(p - 1), para todo v >= p^2.
+static inline int64_t pi_lucy(int64_t x) {
+    if (x < 2) return 0;
+
+    int64_t r = raiz_inteira(x);
+    int64_t *pequenos = malloc((r + 2) * sizeof(int64_t));
+    int64_t *grandes = malloc((r + 2) * sizeof(int64_t));
+    int64_t *novos = malloc((r + 2) * sizeof(int64_t));  // Buffer da atualização paralela
+    if (pequenos == NULL || grandes == NULL || novos == NULL) {
+        fprintf(stderr, "Erro ao alocar memória para pi_lucy\n");
+        exit(1);
+    }
+
+    // Fase 1: inicialização S(v) = v - 1 (todos os inteiros de 2 a v)
+    #pragma omp parallel for schedule(static)
+    for (int64_t i = 1; i <= r; i++) {
+        pequenos[i] = i - 1;
+        grandes[i] = x / i - 1;
+    }
+    pequenos[0] = 0;
+
+    // Fase 2: crivo sobre os valores x / i, um primo por vez.
+    // Dentro de cada primo, todas as atualizações leem valores da rodada anterior;
+    // por isso o resultado vai para 'novos' e só depois é copiado de volta.
+    for (int64_t p = 2; p <= r; p++) {
+        if (pequenos[p] == pequenos[p - 1]) continue;  // p não é primo
+        int64_t sp = pequenos[p - 1];                  // Primos menores que p
+        int64_t p2 = p * p;
+        int64_t lim = (x / p2 < r) ? x / p2 : r;       // Índices grandes afetados
+
+        // Para primos grandes há pouco trabalho: a região paralela não compensa
+        #pragma omp parallel if (lim > 16384)
+        {
+            #pragma omp for schedule(static)
+            for (int64_t i = 1; i <= lim; i++) {
+                int64_t d = i * p;
+                int64_t s = (d <= r) ? grandes[d] : pequenos[x / d];
+                novos[i] = grandes[i] - (s - sp);
+            }
+            #pragma omp for schedule(static)
+            for (int64_t i = 1; i <= lim; i++) {
+                grandes[i] = novos[i];
+            }
+            // Valores pequenos v >= p^2 (mesma técnica; barreira implícita separa as etapas)
+            #pragma omp for schedule(static)
+            for (int64_t v = p2; v <= r; v++) {
+                novos[v] = pequenos[v] - (pequenos[v / p] - sp);
+            }
+            #pragma omp for schedule(static)
+            for (int64_t v = p2; v <= r; v++) {
+                pequenos[v] = novos[v];
+            }
+        }
+    }
+
+    int64_t resultado = grandes[1];
+    free(pequenos);
+    free(grandes);
+    free(novos);
+    return resultado;
+}
+
+#endif // CONTAGEM_PRIMOS_H
@@ -0,0 +1,114 @@
+#ifndef MILLER_RABIN_H
+#define MILLER_RABIN_H
+
+// Teste de primalidade determinístico para inteiros de 64 bits
+// Miller-Rabin com aritmética de Montgomery (sem divisões dentro do laço)
+
+#include <stdint.h>
+#include <stddef.h>
+#include <omp.h>
+
+// Contexto de Montgomery para um módulo ímpar n (R = 2^64)
+typedef struct {
+    uint64_t n;      // Módulo
+    uint64_t n_inv;  // n^-1 mod 2^64
+    uint64_t r2;     // R^2 mod n (converte para a forma de Montgomery)
+    uint64_t um;     // R mod n (representação de 1)
+    uint64_t menos_um; // n - R mod n (representação de n-1)
+} MontgomeryCtx;
+
+// Redução de Montgomery: devolve t * R^-1 mod n, para t < n * 2^64
+static inline uint64_t mont_redc(const MontgomeryCtx *ctx, __uint128_t t) {
+    uint64_t m = (uint64_t)t * ctx->n_inv;                     // Anula a parte baixa
+    uint64_t mn_alto = (uint64_t)(((__uint128_t)m * ctx->n) >> 64);
+    uint64_t t_alto = (uint64_t)(t >> 64);
+    uint64_t r = t_alto - mn_alto;
+    return (t_alto < mn_alto) ? r + ctx->n : r;                // Corrige o empréstimo
+}
+
+static inline uint64_t mont_mul(const MontgomeryCtx *ctx, uint64_t a, uint64_t b) {
+    return mont_redc(ctx, (__uint128_t)a * b);
+}
+
+static inline void mont_init(MontgomeryCtx *ctx, uint64_t n) {
+    uint64_t inv = n;                    // Correto em 3 bits para n ímpar
+    for (int i = 0; i < 5; i++) {
+        inv *= 2 - n * inv;              // Newton: dobra os bits corretos a cada passo
+    }
+    ctx->n = n;
+    ctx->n_inv = inv;
+    ctx->um = (uint64_t)(-n) % n;        // 2^64 mod n
+    ctx->r2 = (uint64_t)(((__uint128_t)ctx->um * ctx->um) % n);
+    ctx->menos_um = n - ctx->um;
+}
+
+// Converte a para a forma de Montgomery (a < n)
+static inline uint64_t mont_de(const MontgomeryCtx *ctx, uint64_t a) {
+    return mont_mul(ctx, a, ctx->r2);
+}
+
+static inline uint64_t mont_pow(const MontgomeryCtx *ctx, uint64_t base_m, uint64_t e) {
+    uint64_t r = ctx->um;
+    while (e > 0) {
+        if (e & 1) r = mont_mul(ctx, r, base_m);
+        base_m = mont_mul(ctx, base_m, base_m);
+        e >>= 1;
+    }
+    return r;
+}
+
+// Uma rodada de Miller-Rabin com testemunha a (n ímpar, n - 1 = d * 2^s)
+static inline int mr_rodada(const MontgomeryCtx *ctx, uint64_t a, uint64_t d, int s) {
+    a %= ctx->n;
+    if (a == 0) return 1;                // Testemunha múltipla de n: não decide nada
+    uint64_t x = mont_pow(ctx, mont_de(ctx, a), d);
+    if (x == ctx->um || x == ctx->menos_um) return 1;
+    for (int i = 1; i < s; i++) {
+        x = mont_mul(ctx, x, x);
+        if (x == ctx->menos_um) return 1;
+    }
+    return 0;                            // a prova que n é composto
+}
+
+// Retorna 1 se n é primo, 0 caso contrário (exato para todo n < 2^64)
+static inline int is_prime_u64(uint64_t n) {
+    // Primos pequenos: resolvem n pequeno e descartam a maioria dos compostos
+    static const uint32_t pequenos[] = {2, 3, 5, 7, 11, 13, 17, 19, 23, 29, 31, 37};
+    for (size_t i = 0; i < sizeof(pequenos) / sizeof(pequenos[0]); i++) {
+        if (n == pequenos[i]) return 1;
+        if (n % pequenos[i] == 0) return 0;
+    }
+    if (n < 41 * 41) return n > 1;
+
+    uint64_t d = n - 1;
+    int s = 0;
+    while ((d & 1) == 0) {
+        d >>= 1;
+        s++;
+    }
+
+    MontgomeryCtx ctx;
+    mont_init(&ctx, n);
+
+    // Conjuntos de testemunhas determinísticos (Jaeschke para 32 bits, Sinclair para 64 bits)
+    static const uint64_t testemunhas32[] = {2, 7, 61};
+    static const uint64_t testemunhas64[] = {2, 325, 9375, 28178, 450775, 9780504, 1795265022};
+    const uint64_t *t = (n >> 32) ? testemunhas64 : testemunhas32;
+    int nt = (n >> 32) ? 7 : 3;
+
+    for (int i = 0; i < nt; i++) {
+        if (!mr_rodada(&ctx, t[i], d, s)) return 0;
+    }
+    return 1;
+}
+
+// Versão em lote: resultado[i] = is_prime_u64(valores[i]), paralelizada com OpenMP
+// Compostos saem na primeira rodada, então o custo varia: schedule guided equilibra
+static inline void is_prime_u64_batch(const uint64_t *valores, unsigned char *resultado, size_t n) {
+    #pragma omp parallel for schedule(guided)
+    for (size_t i = 0; i < n; i++) {
+        resultado[i] = (unsigned char)is_prime_u64(valores[i]);
+    }
+}
+
+#endif // MILLER_RABIN_H
@@ -0,0 +1,267 @@
+#ifndef TABELA_PRIMOS_H
+#define TABELA_PRIMOS_H
+
+// Tabela persistente de primos: bitmap dos ímpares + índice de contagem acumulada,
+// salva em arquivo binário versionado e acessada via mmap nas execuções seguintes.
+//
+// Layout do arquivo:
+//   TabelaCabecalho                         (64 bytes)
+//   bits[num_palavras]     uint64_t         bit k da palavra w <-> número 2*(64w + k) + 1
+//   prefixo[num_blocos+1]  uint64_t         primos ímpares antes de cada bloco de 8 palavras
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <math.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <omp.h>
+#include "miller_rabin.h"
+
+#define TABELA_MAGICO "PRIMTAB"
+#define TABELA_VERSAO 1
+#define TABELA_PALAVRAS_BLOCO 8          // 512 ímpares por entrada do índice
+#define TABELA_BITS_SEGMENTO (1 << 18)   // Segmento do crivo: 32 KB de bitmap (cabe na L1/L2)
+
+typedef struct {
+    char magico[8];
+    uint32_t versao;
+    uint32_t reservado;
+    uint64_t limite;         // Maior n coberto pela tabela
+    uint64_t num_palavras;   // Palavras de 64 bits do bitmap
+    uint64_t num_blocos;     // Entradas do índice (sem contar a sentinela)
+    uint64_t total_primos;   // pi(limite)
+    uint64_t livre[2];
+} TabelaCabecalho;
+
+typedef struct {
+    void *mapa;                       // Região mapeada (arquivo inteiro)
+    size_t tamanho;
+    const TabelaCabecalho *cab;
+    const uint64_t *bits;
+    const uint64_t *prefixo;
+    int origem;                       // TABELA_GERADA, TABELA_ESTENDIDA ou TABELA_REUTILIZADA
+} TabelaPrimos;
+
+#define TABELA_REUTILIZADA 0
+#define TABELA_GERADA 1
+#define TABELA_ESTENDIDA 2
+
+#define TABELA_FORA UINT64_MAX          // tabela_contar para n além do limite
+
+// Primos ímpares até 'limite' por crivo simples (base do crivo segmentado)
+static inline uint32_t *tabela_primos_base(uint64_t limite, size_t *quantidade) {
+    char *composto = calloc(limite + 1, 1);
+    uint32_t *primos = malloc((limite / 2 + 2) * sizeof(uint32_t));
+    if (composto == NULL || primos == NULL) {
+        fprintf(stderr, "Erro ao alocar memória para os primos base\n");
+        exit(1);
+    }
+    size_t n = 0;
+    for (uint64_t i = 3; i <= limite; i += 2) {
+        if (composto[i]) continue;
+        primos[n++] = (uint32_t)i;
+        for (uint64_t j = i * i; j <= limite; j += 2 * i) composto[j] = 1;
+    }
+    free(composto);
+    *quantidade = n;
+    return primos;
+}
+
+// Crivo dos ímpares de índice [k0, k1) no bitmap (k0 e k1 múltiplos de 64, exceto o k1 final).
+// Segmentos alinhados a palavras: cada thread escreve apenas nas próprias palavras.
+static inline void tabela_peneirar(uint64_t *bits, uint64_t k0, uint64_t k1,
+                                   const uint32_t *base, size_t num_base) {
+    uint64_t num_segmentos = (k1 - k0 + TABELA_BITS_SEGMENTO - 1) / TABELA_BITS_SEGMENTO;
+
+    #pragma omp parallel for schedule(dynamic)
+    for (uint64_t s = 0; s < num_segmentos; s++) {
+        uint64_t de = k0 + s * TABELA_BITS_SEGMENTO;
+        uint64_t ate = de + TABELA_BITS_SEGMENTO < k1 ? de + TABELA_BITS_SEGMENTO : k1;
+
+        memset(&bits[de / 64], 0xFF, ((ate - de + 63) / 64) * sizeof(uint64_t));
+        if (de == 0) bits[0] &= ~1ULL;                      // 1 não é primo
+
+        uint64_t n_max = 2 * (ate - 1) + 1;
+        for (size_t j = 0; j < num_base; j++) {
+            uint64_t p = base[j];
+            if (p * p > n_max) break;
+            uint64_t n_de = 2 * de + 1;
+            uint64_t m = p * p;                              // Primeiro múltiplo a remover
+            if (m < n_de) {
+                m = ((n_de + p - 1) / p) * p;
+                if ((m & 1) == 0) m += p;                    // Só múltiplos ímpares
+            }
+            for (uint64_t k = (m - 1) / 2; k < ate; k += p) {
+                bits[k / 64] &= ~(1ULL << (k % 64));
+            }
+        }
+        // Zera os bits além do limite na última palavra
+        if (ate == k1 && (k1 % 64) != 0) {
+            bits[k1 / 64] &= (1ULL << (k1 % 64)) - 1;
+        }
+    }
+}
+
+// Monta o índice de contagem acumulada por bloco de palavras
+static inline uint64_t tabela_indexar(const uint64_t *bits, uint64_t num_palavras,
+                                      uint64_t *prefixo, uint64_t num_blocos) {
+    #pragma omp parallel for schedule(static)
+    for (uint64_t b = 0; b < num_blocos; b++) {
+        uint64_t fim = (b + 1) * TABELA_PALAVRAS_BLOCO;
+        if (fim > num_palavras) fim = num_palavras;
+        uint64_t c = 0;
+        for (uint64_t w = b * TABELA_PALAVRAS_BLOCO; w < fim; w++) c += __builtin_popcountll(bits[w]);
+        prefixo[b + 1] = c;
+    }
+    prefixo[0] = 0;
+    for (uint64_t b = 1; b <= num_blocos; b++) prefixo[b] += prefixo[b - 1];  // Varredura sequencial
+    return prefixo[num_blocos];
+}
+
+// Mapeia um arquivo existente; devolve 0 se ele é válido e cobre 'limite'
+static inline int tabela_mapear(TabelaPrimos *t, const char *caminho) {
+    int fd = open(caminho, O_RDONLY);
+    if (fd < 0) return -1;
+    struct stat st;
+    if (fstat(fd, &st) != 0 || (size_t)st.st_size < sizeof(TabelaCabecalho)) {
+        close(fd);
+        return -1;
+    }
+    void *mapa = mmap(NULL, st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);                                               // O mapeamento continua válido
+    if (mapa == MAP_FAILED) return -1;
+
+    // O cabeçalho precisa bater com o tamanho do arquivo: num_palavras e num_blocos são derivados
+    // de 'limite' (nada de confiar em contagens de um arquivo truncado ou de outra versão), e as
+    // palavras são limitadas pelo tamanho antes de qualquer conta que possa estourar
+    const TabelaCabecalho *cab = mapa;
+    uint64_t palavras_max = ((uint64_t)st.st_size - sizeof(TabelaCabecalho)) / sizeof(uint64_t);
+    int valido = memcmp(cab->magico, TABELA_MAGICO, 8) == 0 && cab->versao == TABELA_VERSAO &&
+                 cab->limite / 128 < palavras_max &&
+                 cab->num_palavras == ((cab->limite + 1) / 2 + 63) / 64 &&
+                 cab->num_blocos == (cab->num_palavras + TABELA_PALAVRAS_BLOCO - 1) / TABELA_PALAVRAS_BLOCO &&
+                 cab->num_palavras + cab->num_blocos + 1 == palavras_max &&
+                 sizeof(TabelaCabecalho) + palavras_max * sizeof(uint64_t) == (size_t)st.st_size;
+    if (valido) {
+        const uint64_t *prefixo = (const uint64_t *)(cab + 1) + cab->num_palavras;
+        valido = prefixo[0] == 0 && prefixo[cab->num_blocos] + (cab->limite >= 2) == cab->total_primos;
+    }
+    if (!valido) {
+        munmap(mapa, st.st_size);                            // Versão antiga ou arquivo corrompido
+        return -1;
+    }
+    t->mapa = mapa;
+    t->tamanho = st.st_size;
+    t->cab = cab;
+    t->bits = (const uint64_t *)(cab + 1);
+    t->prefixo = t->bits + cab->num_palavras;
+    return 0;
+}
+
+static inline void tabela_fechar(TabelaPrimos *t) {
+    if (t->mapa != NULL) munmap(t->mapa, t->tamanho);
+    t->mapa = NULL;
+}
+
+// Gera (ou estende, reaproveitando o bitmap de 'antiga') e grava o arquivo de forma atômica
+static inline int tabela_gerar(const char *caminho, uint64_t limite, const TabelaPrimos *antiga) {
+    uint64_t num_impares = (limite + 1) / 2;                 // Ímpares 1, 3, ..., <= limite
+    uint64_t num_palavras = (num_impares + 63) / 64;
+    uint64_t num_blocos = (num_palavras + TABELA_PALAVRAS_BLOCO - 1) / TABELA_PALAVRAS_BLOCO;
+    size_t tamanho = sizeof(TabelaCabecalho) + (num_palavras + num_blocos + 1) * sizeof(uint64_t);
+
+    unsigned char *buffer = calloc(1, tamanho);
+    if (buffer == NULL) {
+        fprintf(stderr, "Erro ao alocar memória para a tabela de primos\n");
+        exit(1);
+    }
+    TabelaCabecalho *cab = (TabelaCabecalho *)buffer;
+    uint64_t *bits = (uint64_t *)(cab + 1);
+    uint64_t *prefixo = bits + num_palavras;
+
+    // Palavras completas da tabela antiga são copiadas; o crivo recomeça na última (parcial)
+    uint64_t palavras_copiadas = 0;
+    if (antiga != NULL) {
+        palavras_copiadas = ((antiga->cab->limite + 1) / 2) / 64;
+        memcpy(bits, antiga->bits, palavras_copiadas * sizeof(uint64_t));
+    }
+
+    size_t num_base;
+    uint32_t *base = tabela_primos_base((uint64_t)sqrt((double)limite) + 1, &num_base);
+    tabela_peneirar(bits, palavras_copiadas * 64, num_impares, base, num_base);
+    free(base);
+
+    memcpy(cab->magico, TABELA_MAGICO, 8);
+    cab->versao = TABELA_VERSAO;
+    cab->limite = limite;
+    cab->num_palavras = num_palavras;
+    cab->num_blocos = num_blocos;
+    cab->total_primos = tabela_indexar(bits, num_palavras, prefixo, num_blocos) + (limite >= 2);
+
+    // Grava em arquivo temporário e renomeia: leitores nunca veem uma tabela pela metade
+    char temporario[512];
+    snprintf(temporario, sizeof(temporario), "%s.tmp", caminho);
+    FILE *fp = fopen(temporario, "wb");
+    if (fp == NULL) {
+        perror("Erro ao criar a tabela de primos");
+        free(buffer);
+        return -1;
+    }
+    size_t escrito = fwrite(buffer, 1, tamanho, fp);
+    int falhou = (fclose(fp) != 0) || escrito != tamanho;
+    free(buffer);
+    if (falhou || rename(temporario, caminho) != 0) {
+        perror("Erro ao gravar a tabela de primos");
+        remove(temporario);
+        return -1;
+    }
+    return 0;
+}
+
+// Abre a tabela cobrindo pelo menos 'limite': reutiliza o arquivo, estende-o ou gera do zero
+static inline int tabela_abrir(TabelaPrimos *t, const char *caminho, uint64_t limite) {
+    t->mapa = NULL;
+    TabelaPrimos antiga = {0};
+    int existe = (tabela_mapear(&antiga, caminho) == 0);
+
+    if (existe && antiga.cab->limite >= limite) {
+        *t = antiga;
+        t->origem = TABELA_REUTILIZADA;
+        return 0;
+    }
+
+    int r = tabela_gerar(caminho, limite, existe ? &antiga : NULL);
+    if (existe) tabela_fechar(&antiga);
+    if (r != 0 || tabela_mapear(t, caminho) != 0) return -1;
+    t->origem = existe ? TABELA_ESTENDIDA : TABELA_GERADA;
+    return 0;
+}
+
+// Consulta O(1): teste de um bit. Além do limite da tabela, cai no Miller-Rabin
+static inline int tabela_eh_primo(const TabelaPrimos *t, uint64_t n) {
+    if (n < 3) return n == 2;
+    if ((n & 1) == 0) return 0;
+    if (n > t->cab->limite) return is_prime_u64(n);
+    uint64_t k = n / 2;
+    return (int)((t->bits[k / 64] >> (k % 64)) & 1);
+}
+
+// pi(n) para n <= limite: índice do bloco + no máximo 8 popcounts. Acima do limite devolve
+// TABELA_FORA (estender antes com tabela_abrir)
+static inline uint64_t tabela_contar(const TabelaPrimos *t, uint64_t n) {
+    if (n < 2) return 0;
+    if (n > t->cab->limite) return TABELA_FORA;
+    uint64_t k = (n - 1) / 2;                                // Último ímpar <= n
+    uint64_t w = k / 64;
+    uint64_t b = w / TABELA_PALAVRAS_BLOCO;
+    uint64_t c = t->prefixo[b];
+    for (uint64_t i = b * TABELA_PALAVRAS_BLOCO; i < w; i++) c += __builtin_popcountll(t->bits[i]);
+    uint64_t mascara = (k % 64 == 63) ? ~0ULL : ((1ULL << (k % 64 + 1)) - 1);
+    return c + __builtin_popcountll(t->bits[w] & mascara) + 1;   // +1 pelo primo 2
+}
+
+#endif // TABELA_PRIMOS_H
@@ -3,6 +3,10 @@
 #include <math.h>   // Para sqrt()
 #include <omp.h>    // Para OpenMP
 #include <time.h>   // Para medição de tempo
+#include <stdint.h> // Para uint64_t
+#include "miller_rabin.h" // Teste de Miller-Rabin para 64 bits
+#include "contagem_primos.h" // pi(x) sublinear (Lucy_Hedgehog)
+#include "tabela_primos.h"  // Cache persistente de primos via mmap
 
 // Função para verificar se um número é primo
 int eh_primo(int n) {
@@ -44,6 +48,105 @@ int contar_primos_paralelo(int n) {
     return contador;  // Retorna contagem INCORRETA devido à race condition
 }
 
+// Estratégias de distribuição do laço de contagem paralela (corretas, com contadores por thread)
+#define ESC_STATIC  0   // Blocos contíguos iguais: a última thread recebe os i mais caros
+#define ESC_DYNAMIC 1   // Pedaços pequenos distribuídos sob demanda
+#define ESC_GUIDED  2   // Pedaços decrescentes sob demanda
+#define ESC_CUSTO   3   // Blocos contíguos com custo estimado igual (modelo sqrt(i))
+#define NUM_ESTRATEGIAS 4
+#define MAX_THREADS_ESC 256
+
+const char* nomes_estrategias[NUM_ESTRATEGIAS] = {"static", "dynamic,1024", "guided", "modelo de custo"};
+
+// Limite do bloco k de T com custo igual: o custo acumulado de [2, x] é ~ (2/3) x^(3/2),
+// então o k-ésimo limite fica em n * (k/T)^(2/3)
+int limite_bloco_custo(int n, int k, int total) {
+    if (k >= total) return n + 1;
+    if (k <= 0) return 2;
+    int limite = (int)(n * pow((double)k / total, 2.0 / 3.0));
+    return limite < 2 ? 2 : limite;
+}
+
+// Contagem paralela correta: cada thread acumula em um contador local (reduction)
+// e registra em ocupado[tid] o tempo gasto no próprio laço, sem contar a espera na barreira
+int contar_primos_escalonado(int n, int estrategia, double *ocupado) {
+    int contador = 0;
+
+    #pragma omp parallel reduction(+:contador)
+    {
+        int tid = omp_get_thread_num();
+        int nthreads = omp_get_num_threads();
+        double inicio = omp_get_wtime();
+
+        if (estrategia == ESC_CUSTO) {
+            int de = limite_bloco_custo(n, tid, nthreads);
+            int ate = limite_bloco_custo(n, tid + 1, nthreads);
+            for (int i = de; i < ate; i++) {
+                if (eh_primo(i)) contador++;
+            }
+        } else if (estrategia == ESC_DYNAMIC) {
+            #pragma omp for schedule(dynamic, 1024) nowait
+            for (int i = 2; i <= n; i++) {
+                if (eh_primo(i)) contador++;
+            }
+        } else if (estrategia == ESC_GUIDED) {
+            #pragma omp for schedule(guided) nowait
+            for (int i = 2; i <= n; i++) {
+                if (eh_primo(i)) contador++;
+            }
+        } else {
+            #pragma omp for schedule(static) nowait
+            for (int i = 2; i <= n; i++) {
+                if (eh_primo(i)) contador++;
+            }
+        }
+
+        if (tid < MAX_THREADS_ESC) ocupado[tid] = omp_get_wtime() - inicio;
+    }
+
+    return contador;
+}
+
+// Compara as estratégias: tempo de parede, speedup, tempo ocupado por thread e desbalanceamento
+void comparar_escalonamentos(int n, int primos_ref, double tempo_seq) {
+    int nthreads = omp_get_max_threads();
+    if (nthreads > MAX_THREADS_ESC) nthreads = MAX_THREADS_ESC;
+    double ocupado[MAX_THREADS_ESC];
+
+    printf("\n=== BALANCEAMENTO DE CARGA (n = %d, %d threads) ===\n", n, nthreads);
+    printf("Custo de eh_primo(i) ~ sqrt(i): blocos contíguos iguais sobrecarregam a última thread\n");
+    printf("%-18s %-10s %-12s %-10s %-12s %-14s %-10s\n",
+           "Estratégia", "Primos", "Tempo (s)", "Speedup", "Ideal", "Desbalanc.", "Status");
+
+    for (int e = 0; e < NUM_ESTRATEGIAS; e++) {
+        for (int t = 0; t < nthreads; t++) ocupado[t] = 0.0;
+
+        double inicio = omp_get_wtime();
+        int primos = contar_primos_escalonado(n, e, ocupado);
+        double tempo = omp_get_wtime() - inicio;
+
+        // Desbalanceamento = (máximo / médio) - 1: 0% significa todas as threads ocupadas igualmente
+        double soma = 0.0, maximo = 0.0;
+        for (int t = 0; t < nthreads; t++) {
+            soma += ocupado[t];
+            if (ocupado[t] > maximo) maximo = ocupado[t];
+        }
+        double media = soma / nthreads;
+        double desbalanceamento = (media > 0) ? (maximo / media - 1.0) * 100.0 : 0.0;
+
+        char texto_desb[32];
+        snprintf(texto_desb, sizeof(texto_desb), "%.1f%%", desbalanceamento);
+
+        printf("%-18s %-10d %-12.6f %-10.2f %-12d %-14s %-10s\n",
+               nomes_estrategias[e], primos, tempo, tempo_seq / tempo, nthreads, texto_desb,
+               primos == primos_ref ? "CORRETO" : "ERRO");
+
+        printf("    ocupado por thread (s):");
+        for (int t = 0; t < nthreads; t++) printf(" %.4f", ocupado[t]);
+        printf("\n");
+    }
+}
+
 // Função para medir tempo de execução usando ponteiro para função
 double medir_tempo(int (*funcao)(int), int n) {
     double inicio = omp_get_wtime();  // Marca tempo de início (alta precisão)
@@ -52,7 +155,268 @@ double medir_tempo(int (*funcao)(int), int n) {
     return fim - inicio;              // Retorna tempo decorrido em segundos
 }
 
-int main() {
+// Divisão por tentativa em 64 bits - referência para validar o Miller-Rabin
+int eh_primo_u64_divisao(uint64_t n) {
+    if (n < 2) return 0;
+    if (n % 2 == 0) return n == 2;
+    for (uint64_t i = 3; i <= n / i; i += 2) {  // i <= n/i evita overflow de i*i
+        if (n % i == 0) return 0;
+    }
+    return 1;
+}
+
+// Gerador splitmix64 para produzir entradas aleatórias reproduzíveis
+uint64_t proximo_u64(uint64_t *estado) {
+    uint64_t z = (*estado += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+// Casos difíceis com resposta conhecida: entradas aleatórias quase nunca exercitam as
+// testemunhas nem a redução de Montgomery perto de 2^64
+typedef struct {
+    uint64_t n;
+    int primo;
+    const char *descricao;
+} CasoPrimalidade;
+
+static const CasoPrimalidade casos_dificeis[] = {
+    // Pseudoprimos fortes: passam pelas primeiras bases e precisam do conjunto completo
+    {25326001ULL, 0, "spsp(2,3,5)"},
+    {3215031751ULL, 0, "spsp(2,3,5,7)"},
+    {4759123141ULL, 0, "spsp(2,7,61)"},
+    {2152302898747ULL, 0, "spsp(2..11)"},
+    {3474749660383ULL, 0, "spsp(2..13)"},
+    {341550071728321ULL, 0, "spsp(2..17)"},
+    {3825123056546413051ULL, 0, "spsp(2..23)"},
+    // Números de Carmichael
+    {561ULL, 0, "Carmichael"},
+    {1105ULL, 0, "Carmichael"},
+    {1729ULL, 0, "Carmichael"},
+    {2465ULL, 0, "Carmichael"},
+    {2821ULL, 0, "Carmichael"},
+    {6601ULL, 0, "Carmichael"},
+    {8911ULL, 0, "Carmichael"},
+    {41041ULL, 0, "Carmichael"},
+    {825265ULL, 0, "Carmichael"},
+    {321197185ULL, 0, "Carmichael"},
+    {5394826801ULL, 0, "Carmichael"},
+    {232250619601ULL, 0, "Carmichael"},
+    {9746347772161ULL, 0, "Carmichael"},
+    // Maiores primos abaixo de 2^64, 2^63 e 2^32, e outros primos grandes
+    {18446744073709551557ULL, 1, "2^64 - 59"},
+    {18446744073709551533ULL, 1, "2^64 - 83"},
+    {9223372036854775783ULL, 1, "2^63 - 25"},
+    {4294967291ULL, 1, "2^32 - 5"},
+    {2305843009213693951ULL, 1, "2^61 - 1"},
+    {999999999989ULL, 1, "maior primo < 10^12"},
+    // Compostos perto de 2^64 e quadrados/produtos de primos grandes
+    {18446744073709551615ULL, 0, "2^64 - 1"},
+    {18446744073709551559ULL, 0, "2^64 - 57"},
+    {18446744030759878681ULL, 0, "(2^32 - 5)^2"},
+    {18446743927680663841ULL, 0, "(2^32 - 17)^2"},
+    {18446743979220271189ULL, 0, "(2^32 - 5)(2^32 - 17)"},
+    {9223371994482243049ULL, 0, "3037000493^2"},
+    {4611686014132420609ULL, 0, "(2^31 - 1)^2"},
+};
+
+// Confere is_prime_u64 e is_prime_u64_batch nos casos difíceis; encerra com erro se algum falhar
+void conferir_casos_dificeis(void) {
+    const int num = sizeof(casos_dificeis) / sizeof(casos_dificeis[0]);
+    uint64_t valores[sizeof(casos_dificeis) / sizeof(casos_dificeis[0])];
+    unsigned char res_lote[sizeof(casos_dificeis) / sizeof(casos_dificeis[0])];
+    for (int i = 0; i < num; i++) valores[i] = casos_dificeis[i].n;
+    is_prime_u64_batch(valores, res_lote, num);
+
+    int erros = 0;
+    for (int i = 0; i < num; i++) {
+        int mr = is_prime_u64(casos_dificeis[i].n);
+        if (mr != casos_dificeis[i].primo || res_lote[i] != casos_dificeis[i].primo) {
+            fprintf(stderr, "ERRO: is_prime_u64(%llu) = %d, lote = %d, esperado %d (%s)\n",
+                    (unsigned long long)casos_dificeis[i].n, mr, res_lote[i], casos_dificeis[i].primo,
+                    casos_dificeis[i].descricao);
+            erros++;
+        }
+    }
+    printf("Casos difíceis (pseudoprimos fortes, Carmichael, primos perto de 2^64, quadrados): %d/%d (%s)\n",
+           num - erros, num, erros == 0 ? "CORRETO" : "ERRO");
+    if (erros > 0) exit(1);
+}
+
+// Compara eh_primo com is_prime_u64 em entradas aleatórias de 32 e 64 bits
+void comparar_miller_rabin(void) {
+    const int qtd32 = 200000;   // Entradas de 32 bits (limitadas a INT_MAX, faixa de eh_primo)
+    const int qtd64 = 1000000;  // Entradas de 64 bits para o Miller-Rabin
+    const int qtd64_div = 8;    // Divisão por tentativa em 64 bits é lenta: amostra pequena
+    uint64_t estado = 2024;
+
+    uint64_t *valores = malloc(qtd64 * sizeof(uint64_t));
+    unsigned char *res_lote = malloc(qtd64);
+    if (valores == NULL || res_lote == NULL) {
+        fprintf(stderr, "Erro ao alocar memória para o benchmark\n");
+        exit(1);
+    }
+
+    printf("\n=== MILLER-RABIN DETERMINÍSTICO vs DIVISÃO POR TENTATIVA ===\n");
+    conferir_casos_dificeis();
+
+    // Entradas de 32 bits: as duas funções são comparadas no mesmo conjunto
+    for (int i = 0; i < qtd32; i++) {
+        valores[i] = proximo_u64(&estado) & 0x7FFFFFFF;
+    }
+
+    double inicio = omp_get_wtime();
+    int primos_div = 0;
+    for (int i = 0; i < qtd32; i++) primos_div += eh_primo((int)valores[i]);
+    double tempo_div = omp_get_wtime() - inicio;
+
+    inicio = omp_get_wtime();
+    int primos_mr = 0;
+    for (int i = 0; i < qtd32; i++) primos_mr += is_prime_u64(valores[i]);
+    double tempo_mr = omp_get_wtime() - inicio;
+
+    inicio = omp_get_wtime();
+    is_prime_u64_batch(valores, res_lote, qtd32);
+    double tempo_lote = omp_get_wtime() - inicio;
+
+    int divergencias = 0;
+    for (int i = 0; i < qtd32; i++) {
+        if (res_lote[i] != eh_primo((int)valores[i])) divergencias++;
+    }
+
+    printf("%-28s %-12s %-15s %-18s\n", "Método (32 bits)", "Primos", "Tempo (s)", "Números/s");
+    printf("%-28s %-12d %-15.6f %-18.0f\n", "eh_primo", primos_div, tempo_div, qtd32 / tempo_div);
+    printf("%-28s %-12d %-15.6f %-18.0f\n", "is_prime_u64", primos_mr, tempo_mr, qtd32 / tempo_mr);
+    printf("%-28s %-12s %-15.6f %-18.0f\n", "is_prime_u64_batch", "-", tempo_lote, qtd32 / tempo_lote);
+    printf("Divergências entre os métodos: %d (%s)\n", divergencias, divergencias == 0 ? "CORRETO" : "ERRO");
+
+    // Entradas de 64 bits: eh_primo não suporta, usa-se a divisão em uint64_t como referência
+    for (int i = 0; i < qtd64; i++) {
+        valores[i] = proximo_u64(&estado) | 1;  // Ímpares, para não ficar trivial
+    }
+
+    inicio = omp_get_wtime();
+    int primos64 = 0;
+    for (int i = 0; i < qtd64; i++) primos64 += is_prime_u64(valores[i]);
+    double tempo_mr64 = omp_get_wtime() - inicio;
+
+    inicio = omp_get_wtime();
+    is_prime_u64_batch(valores, res_lote, qtd64);
+    double tempo_lote64 = omp_get_wtime() - inicio;
+
+    inicio = omp_get_wtime();
+    divergencias = 0;
+    for (int i = 0; i < qtd64_div; i++) {
+        if (eh_primo_u64_divisao(valores[i]) != res_lote[i]) divergencias++;
+    }
+    double tempo_div64 = omp_get_wtime() - inicio;
+
+    printf("\n%-28s %-12s %-15s %-18s\n", "Método (64 bits)", "Amostra", "Tempo (s)", "Números/s");
+    printf("%-28s %-12d %-15.6f %-18.0f\n", "divisão (uint64_t)", qtd64_div, tempo_div64, qtd64_div / tempo_div64);
+    printf("%-28s %-12d %-15.6f %-18.0f\n", "is_prime_u64", qtd64, tempo_mr64, qtd64 / tempo_mr64);
+    printf("%-28s %-12d %-15.6f %-18.0f\n", "is_prime_u64_batch", qtd64, tempo_lote64, qtd64 / tempo_lote64);
+    printf("Primos encontrados: %d | Divergências na amostra: %d (%s)\n",
+           primos64, divergencias, divergencias == 0 ? "CORRETO" : "ERRO");
+
+    free(valores);
+    free(res_lote);
+}
+
+// Valida pi_lucy contra as contagens por divisão e mede pi(x) para x grandes
+void comparar_pi_lucy(const int *valores_n, const int *primos_ref, int num_testes, int expoente_max) {
+    printf("\n=== CONTAGEM SUBLINEAR pi(x) - LUCY_HEDGEHOG ===\n");
+    printf("%-12s %-12s %-12s %-15s %-10s\n", "N", "Divisão", "pi_lucy", "Tempo (s)", "Status");
+    for (int i = 0; i < num_testes; i++) {
+        double inicio = omp_get_wtime();
+        int64_t pi = pi_lucy(valores_n[i]);
+        double tempo = omp_get_wtime() - inicio;
+        printf("%-12d %-12d %-12lld %-15.6f %-10s\n", valores_n[i], primos_ref[i], (long long)pi, tempo,
+               pi == primos_ref[i] ? "CORRETO" : "ERRO");
+    }
+
+    // Valores de referência conhecidos de pi(10^k)
+    static const int64_t pi_potencias[] = {
+        0, 4, 25, 168, 1229, 9592, 78498, 664579, 5761455, 50847534, 455052511,
+        4118054813LL, 37607912018LL, 346065536839LL, 3204941750802LL
+    };
+    printf("\n%-8s %-18s %-18s %-15s %-10s\n", "x", "pi_lucy", "Referência", "Tempo (s)", "Status");
+    int64_t x = 10;
+    for (int k = 1; k <= expoente_max && k <= 14; k++, x *= 10) {
+        if (k < 8) continue;  // Potências pequenas já cobertas acima
+        double inicio = omp_get_wtime();
+        int64_t pi = pi_lucy(x);
+        double tempo = omp_get_wtime() - inicio;
+        printf("10^%-5d %-18lld %-18lld %-15.6f %-10s\n", k, (long long)pi, (long long)pi_potencias[k], tempo,
+               pi == pi_potencias[k] ? "CORRETO" : "ERRO");
+    }
+}
+
+// Usa a tabela persistente (primos.tab): consulta O(1) e pi(n) pelo índice de prefixos
+void comparar_tabela_primos(const int *valores_n, const int *primos_ref, int num_testes) {
+    const char *caminho = "primos.tab";
+    const char *origens[] = {"reutilizada (mmap)", "gerada", "estendida"};
+    uint64_t limite = valores_n[num_testes - 1];
+    TabelaPrimos tabela;
+
+    printf("\n=== TABELA PERSISTENTE DE PRIMOS (%s) ===\n", caminho);
+
+    double inicio = omp_get_wtime();
+    if (tabela_abrir(&tabela, caminho, limite) != 0) {
+        fprintf(stderr, "Não foi possível abrir a tabela de primos\n");
+        return;
+    }
+    printf("Tabela até %llu %s em %.6f s (%zu bytes)\n", (unsigned long long)tabela.cab->limite,
+           origens[tabela.origem], omp_get_wtime() - inicio, tabela.tamanho);
+
+    printf("%-12s %-12s %-14s %-10s\n", "N", "Divisão", "tabela_contar", "Status");
+    for (int i = 0; i < num_testes; i++) {
+        uint64_t pi = tabela_contar(&tabela, valores_n[i]);
+        printf("%-12d %-12d %-14llu %-10s\n", valores_n[i], primos_ref[i], (unsigned long long)pi,
+               pi == (uint64_t)primos_ref[i] ? "CORRETO" : "ERRO");
+    }
+
+    // Consultas aleatórias: bit da tabela contra a divisão por tentativa
+    const int consultas = 1000000;
+    uint64_t estado = 7;
+    int *numeros = malloc(consultas * sizeof(int));
+    if (numeros == NULL) {
+        fprintf(stderr, "Erro ao alocar memória para as consultas\n");
+        exit(1);
+    }
+    for (int i = 0; i < consultas; i++) numeros[i] = 2 + (int)(proximo_u64(&estado) % (limite - 1));
+
+    inicio = omp_get_wtime();
+    int primos_div = 0;
+    for (int i = 0; i < consultas; i++) primos_div += eh_primo(numeros[i]);
+    double tempo_div = omp_get_wtime() - inicio;
+
+    inicio = omp_get_wtime();
+    int primos_tab = 0;
+    for (int i = 0; i < consultas; i++) primos_tab += tabela_eh_primo(&tabela, numeros[i]);
+    double tempo_tab = omp_get_wtime() - inicio;
+
+    printf("%d consultas: eh_primo %.6f s | tabela_eh_primo %.6f s (%.0fx) | %s\n", consultas,
+           tempo_div, tempo_tab, tempo_div / tempo_tab, primos_div == primos_tab ? "CORRETO" : "ERRO");
+    free(numeros);
+    tabela_fechar(&tabela);
+
+    // Pedido maior: só o trecho novo é peneirado, o bitmap existente é reaproveitado
+    inicio = omp_get_wtime();
+    if (tabela_abrir(&tabela, caminho, limite * 10) == 0) {
+        printf("Tabela até %llu %s em %.6f s | pi = %llu\n", (unsigned long long)tabela.cab->limite,
+               origens[tabela.origem], omp_get_wtime() - inicio,
+               (unsigned long long)tabela_contar(&tabela, limite * 10));
+        tabela_fechar(&tabela);
+    }
+}
+
+int main(int argc, char *argv[]) {
+    // Maior expoente de x = 10^k para pi_lucy (padrão 12; 13 leva alguns segundos por núcleo)
+    int expoente_max = 12;
+    if (argc > 1) expoente_max = atoi(argv[1]);
+
+
     // Fixar número de threads em 4 para testes consistentes
     omp_set_num_threads(4);
     
@@ -62,6 +426,8 @@ int main() {
     // Array com valores de teste crescentes para demonstrar comportamento
     int valores_n[] = {1000, 10000, 100000, 1000000, 10000000};
     int num_testes = sizeof(valores_n) / sizeof(valores_n[0]);  // Calcula quantidade de testes
+    int primos_ref[sizeof(valores_n) / sizeof(valores_n[0])];  // Contagens sequenciais para validação
+    double tempo_seq_maior = 0.0;  // Tempo sequencial do maior n, base do speedup do balanceamento
     
     printf("\n=== RESULTADOS DOS TESTES ===\n");
     // Cabeçalho da tabela de resultados com formatação alinhada
@@ -76,6 +442,8 @@ int main() {
         // Medindo tempo e resultado da versão sequencial (referência correta)
         double tempo_seq = medir_tempo(contar_primos_sequencial, n);
         int primos_seq = contar_primos_sequencial(n);  // Resultado CORRETO
+        primos_ref[i] = primos_seq;
+        tempo_seq_maior = tempo_seq;
         
         // Medindo tempo e resultado da versão paralela (com race condition)
         double tempo_par = medir_tempo(contar_primos_paralelo, n);
@@ -92,6 +460,18 @@ int main() {
                n, primos_seq, primos_par, tempo_seq, tempo_par, speedup, status);
     } 
 
+    // Versões corretas com diferentes distribuições de carga, no maior n testado
+    comparar_escalonamentos(valores_n[num_testes - 1], primos_ref[num_testes - 1], tempo_seq_maior);
+
+    // Teste de primalidade para consultas esparsas em 64 bits
+    comparar_miller_rabin();
+
+    // Contagem sem enumerar os inteiros, validada contra a tabela acima
+    comparar_pi_lucy(valores_n, primos_ref, num_testes, expoente_max);
+
+    // Primos pré-calculados em arquivo, reaproveitados entre execuções
+    comparar_tabela_primos(valores_n, primos_ref, num_testes);
+
     return 0;  // Programa executado com sucesso
 }
 
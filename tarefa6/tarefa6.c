@@ -4,6 +4,10 @@
 #include <math.h>
 #include <time.h>
 #include <omp.h>
+#include "../comum/rng.h"
+#include "../comum/mc_simd.h"
+#include "../comum/telemetria.h"
+#include "../comum/registro.h"
 
 #ifndef M_PI
 #define M_PI 3.14159265358979323846
@@ -124,13 +128,13 @@ double estimar_pi_private(long num_pontos) {
             }
         }
         
+        REGISTRAR("Thread %d: %ld pontos\n", thread_id, pontos_locais); // Fora da região crítica
+        
         #pragma omp critical
-        {
-            printf("Thread %d: %ld pontos\n", thread_id, pontos_locais);
-            pontos_dentro += pontos_locais;
-        }
+        pontos_dentro += pontos_locais;
     }
     
+    REGISTRO_SINCRONIZAR(); // Linhas das threads antes do printf seguinte
     printf("Depois: pontos_locais=%ld, thread_id=%d (valores originais inalterados)\n", pontos_locais, thread_id);
     
     return 4.0 * pontos_dentro / num_pontos;
@@ -168,14 +172,14 @@ double estimar_pi_firstprivate(long num_pontos) {
         contador_inicial += pontos_locais;   // Modificação local (não afeta original)
         multiplicador *= thread_id + 1;      // Modificação local (não afeta original)
         
+        REGISTRAR("Thread %d: contador=%ld, mult=%d, pontos=%ld\n", 
+                  thread_id, contador_inicial, multiplicador, pontos_locais);
+        
         #pragma omp critical
-        {
-            printf("Thread %d: contador=%ld, mult=%d, pontos=%ld\n", 
-                   thread_id, contador_inicial, multiplicador, pontos_locais);
-            pontos_dentro += pontos_locais;
-        }
+        pontos_dentro += pontos_locais;
     }
     
+    REGISTRO_SINCRONIZAR();
     printf("Depois: contador_inicial=%ld, multiplicador=%d (valores originais preservados)\n", contador_inicial, multiplicador);
     
     return 4.0 * pontos_dentro / num_pontos;
@@ -184,16 +188,19 @@ double estimar_pi_firstprivate(long num_pontos) {
 // 7. Demonstração com shared
 double estimar_pi_shared(long num_pontos) {
     long pontos_dentro = 0;
-    long contador_compartilhado = 0; // Variável compartilhada - todas threads acessam
-    double progresso = 0.0;          // Também compartilhada
+    long contador_compartilhado = 0; // Total de pontos processados, lido da telemetria após a região
+    double progresso = 0.0;
+    Telemetria tel;                  // Compartilhada: um slot por thread + thread relatora em segundo plano
     
     printf("\n=== CLÁUSULA: SHARED ===\n");
     printf("Variáveis compartilhadas: contador=%ld, progresso=%.1f%%\n", contador_compartilhado, progresso * 100);
     
-    #pragma omp parallel shared(pontos_dentro, contador_compartilhado, progresso, num_pontos)
+    telemetria_iniciar(&tel, "shared", num_pontos, omp_get_max_threads(), 0.25);
+    #pragma omp parallel shared(pontos_dentro, num_pontos, tel)
     {
         int thread_id = omp_get_thread_num();
         long pontos_locais = 0; // Esta é automática private (declarada dentro)
+        long processados = 0;   // Também private: publicada na telemetria a cada TELEMETRIA_K pontos
         unsigned int seed = 12345 + thread_id * 1000;
         
         #pragma omp for
@@ -205,30 +212,63 @@ double estimar_pi_shared(long num_pontos) {
                 pontos_locais++;
             }
             
-            // Demonstrar acesso sincronizado a variáveis compartilhadas
-            #pragma omp atomic  // Protege o incremento
-            contador_compartilhado++;
-            
-            // Atualizar progresso ocasionalmente
-            if (i % 10000 == 0) {
-                #pragma omp atomic write
-                progresso = (double)contador_compartilhado / num_pontos;
-            }
+            // Sem atomic por ponto: store relaxado no slot da thread só a cada TELEMETRIA_K pontos
+            processados++;
+            TELEMETRIA_PASSO(&tel, thread_id, processados);
         }
+        telemetria_publicar(&tel, thread_id, processados); // Valor final exato
+        
+        REGISTRAR("Thread %d: %ld pontos\n", thread_id, pontos_locais);
         
         #pragma omp critical
-        {
-            printf("Thread %d: %ld pontos\n", thread_id, pontos_locais);
-            pontos_dentro += pontos_locais;
-        }
+        pontos_dentro += pontos_locais;
     }
     
-    printf("Final: contador=%ld, progresso=%.1f%% (modificadas por todas threads)\n", 
+    REGISTRO_SINCRONIZAR();
+    contador_compartilhado = telemetria_finalizar(&tel); // Após a barreira: soma exata dos slots
+    progresso = (double)contador_compartilhado / num_pontos;
+    printf("Final: contador=%ld, progresso=%.1f%% (somados dos slots de todas as threads)\n", 
            contador_compartilhado, progresso * 100);
     
     return 4.0 * pontos_dentro / num_pontos;
 }
 
+// Sobrecarga da telemetria: mesmo laço de estimar_pi_shared com e sem publicação de progresso
+void medir_sobrecarga_telemetria(long num_pontos) {
+    double melhor[2] = {1e30, 1e30};
+    for (int rep = 0; rep < 6; rep++) {
+        for (int k = 0; k < 2; k++) {
+            int com = (rep + k) % 2; // Alterna a ordem para não favorecer nenhuma das versões
+            Telemetria tel;
+            long pontos_dentro = 0;
+            if (com) telemetria_iniciar(&tel, NULL, num_pontos, omp_get_max_threads(), 0.25);
+            double inicio = omp_get_wtime();
+            #pragma omp parallel reduction(+:pontos_dentro)
+            {
+                int thread_id = omp_get_thread_num();
+                long processados = 0;
+                unsigned int seed = 12345 + thread_id * 1000;
+                #pragma omp for
+                for (long i = 0; i < num_pontos; i++) {
+                    double x = (double)rand_r(&seed) / RAND_MAX * 2.0 - 1.0;
+                    double y = (double)rand_r(&seed) / RAND_MAX * 2.0 - 1.0;
+                    if (x*x + y*y <= 1.0) pontos_dentro++;
+                    if (com) {
+                        processados++;
+                        TELEMETRIA_PASSO(&tel, thread_id, processados);
+                    }
+                }
+                if (com) telemetria_publicar(&tel, thread_id, processados);
+            }
+            double tempo = omp_get_wtime() - inicio;
+            if (com) telemetria_finalizar(&tel);
+            if (tempo < melhor[com]) melhor[com] = tempo;
+        }
+    }
+    printf("Sem telemetria: %.4f s | Com telemetria: %.4f s | Sobrecarga: %+.2f%%\n",
+           melhor[0], melhor[1], 100.0 * (melhor[1] - melhor[0]) / melhor[0]);
+}
+
 // 8. Demonstração com lastprivate
 double estimar_pi_lastprivate(long num_pontos) {
     long pontos_dentro = 0;
@@ -270,6 +310,52 @@ double estimar_pi_lastprivate(long num_pontos) {
     return 4.0 * pontos_dentro / num_pontos;
 }
 
+// 9. Gerador baseado em contador (Philox4x32-10): reprodutível para qualquer número de threads
+#define SEMENTE_PHILOX 12345
+
+double estimar_pi_philox(long num_pontos) {
+    long pontos_dentro = 0;
+    long num_pares = (num_pontos + 1) / 2;  // Cada chamada do Philox gera 4 valores = 2 pontos
+
+    // O par j sempre usa o contador j: não importa qual thread o processa
+    #pragma omp parallel for reduction(+:pontos_dentro)
+    for (long j = 0; j < num_pares; j++) {
+        Philox4x32 r = philox_gerar(SEMENTE_PHILOX, (uint64_t)j);
+
+        double x = rng_u32_para_double(r.v[0]) * 2.0 - 1.0;
+        double y = rng_u32_para_double(r.v[1]) * 2.0 - 1.0;
+        if (x*x + y*y <= 1.0) pontos_dentro++;
+
+        if (2 * j + 1 < num_pontos) {  // Segundo ponto do par (se N for ímpar, descartado)
+            x = rng_u32_para_double(r.v[2]) * 2.0 - 1.0;
+            y = rng_u32_para_double(r.v[3]) * 2.0 - 1.0;
+            if (x*x + y*y <= 1.0) pontos_dentro++;
+        }
+    }
+
+    return 4.0 * pontos_dentro / num_pontos;
+}
+
+// 10. Kernel SIMD: 8 ou 16 pontos por iteração, sem divisão e sem desvio
+#define PONTOS_POR_BLOCO 65536
+
+double estimar_pi_simd(long num_pontos) {
+    long pontos_dentro = 0;
+    long num_blocos = (num_pontos + PONTOS_POR_BLOCO - 1) / PONTOS_POR_BLOCO;
+    mc_kernel_fn kernel = mc_simd_kernel(mc_simd_isa_detectada()); // AVX-512, AVX2 ou escalar
+    
+    // Cada bloco tem seus próprios fluxos (um por lane): resultado independe das threads
+    #pragma omp parallel for schedule(static) reduction(+:pontos_dentro)
+    for (long b = 0; b < num_blocos; b++) {
+        long inicio = b * PONTOS_POR_BLOCO;
+        long tamanho = (inicio + PONTOS_POR_BLOCO <= num_pontos) ? PONTOS_POR_BLOCO : num_pontos - inicio;
+        pontos_dentro += kernel(SEMENTE_PHILOX, (uint64_t)b, tamanho);
+    }
+    
+    // O kernel sorteia em [0, 1)²: a razão de acertos também é π/4
+    return 4.0 * pontos_dentro / num_pontos;
+}
+
 // Função auxiliar para testar e medir tempo
 void testar_implementacao(const char* nome, double (*funcao)(long), long num_pontos) {
     printf("\n========================================\n");
@@ -290,19 +376,25 @@ void testar_implementacao(const char* nome, double (*funcao)(long), long num_pon
     printf("π real:     %.6f\n", M_PI);
     printf("Erro:       %.6f (%.3f%%)\n", erro, erro_percentual);
     printf("Tempo:      %.4f segundos\n", tempo_fim - tempo_inicio);
+    printf("Vazão:      %.1f Mpontos/s (%.1f por thread)\n",
+           num_pontos / (tempo_fim - tempo_inicio) / 1e6,
+           num_pontos / (tempo_fim - tempo_inicio) / 1e6 / omp_get_max_threads());
 }
 
-int main() {
+int main(int argc, char *argv[]) {
     // Configurar o número de threads para 4
     omp_set_num_threads(4);
     
     long num_pontos = 250000000; // 250 milhões de pontos para demonstração com formatação limpa
+    if (argc > 1) num_pontos = atol(argv[1]); // Permite testar com menos pontos
     
     printf("=== ESTIMATIVA DE π USANDO MÉTODO DE MONTE CARLO ===\n");
     printf("Número de pontos: %ld\n", num_pontos);
     printf("Número de threads configuradas: %d\n", omp_get_max_threads());
     printf("Valor real de π: %.10f\n", M_PI);
     
+    REGISTRO_INICIAR(STDOUT_FILENO, 0.05); // Linhas impressas pelas threads nas demonstrações das cláusulas
+    
     // 1. Versão sequencial (referência)
     testar_implementacao("VERSÃO SEQUENCIAL", estimar_pi_sequencial, num_pontos);
     
@@ -331,5 +423,25 @@ int main() {
     
     testar_implementacao("CLÁUSULA LASTPRIVATE", estimar_pi_lastprivate, num_pontos);
     
+    // 6. Fluxo aleatório independente do número de threads
+    printf("\n\n*** GERADOR PHILOX: MESMO RESULTADO PARA QUALQUER NÚMERO DE THREADS ***\n");
+    testar_implementacao("PHILOX4x32-10 (contador por par de pontos)", estimar_pi_philox, num_pontos);
+    
+    int max_threads = omp_get_max_threads();
+    for (int t = 1; t <= max_threads; t *= 2) {
+        omp_set_num_threads(t);
+        printf("Philox com %d thread(s): π = %.10f\n", t, estimar_pi_philox(num_pontos));
+    }
+    omp_set_num_threads(max_threads);
+    
+    // Custo da telemetria de progresso usada em estimar_pi_shared (alvo: < 1%)
+    printf("\n\n*** SOBRECARGA DA TELEMETRIA DE PROGRESSO (melhor de 6) ***\n");
+    medir_sobrecarga_telemetria(num_pontos);
+    
+    // 7. Kernel vetorizado (comparar a vazão com a versão REESTRUTURADO)
+    printf("\n\n*** KERNEL SIMD (%s) ***\n", mc_simd_nome(mc_simd_isa_detectada()));
+    testar_implementacao("SIMD (xoshiro128++ vetorial + popcount)", estimar_pi_simd, num_pontos);
+    
+    REGISTRO_FINALIZAR();
     return 0;
 }
@@ -0,0 +1,154 @@
+#define _USE_MATH_DEFINES
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <stdatomic.h>
+#include <omp.h>
+#include "../comum/mc_simd.h"
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+#define PONTOS_POR_LOTE 65536   // Cada lote é processado inteiro e depois somado à estimativa
+#define LOTES_MINIMOS 16        // Evita parar cedo com uma estimativa de variância ruim
+#define SEMENTE 12345
+
+#define PARADA_FLAG 0           // Flag compartilhada lida com memory_order_relaxed
+#define PARADA_CANCEL 1         // #pragma omp cancel for (requer OMP_CANCELLATION=true)
+
+typedef struct {
+    double pi;
+    double erro_padrao;
+    long long pontos;
+    double tempo;
+} ResultadoAdaptativo;
+
+// Erro-padrão de 4 * p, com p = acertos / n (distribuição binomial)
+double erro_padrao_pi(long long acertos, long long n) {
+    double p = (double)acertos / n;
+    return 4.0 * sqrt(p * (1.0 - p) / n);
+}
+
+// Processa lotes até o erro-padrão da estimativa ficar abaixo de 'alvo' (ou até max_pontos)
+ResultadoAdaptativo estimar_pi_adaptativo(double alvo, long long max_pontos, int modo) {
+    mc_kernel_fn kernel = mc_simd_kernel(mc_simd_isa_detectada());
+    long long max_lotes = max_pontos / PONTOS_POR_LOTE;
+    long long acertos_total = 0, pontos_total = 0; // Estimativa compartilhada (protegida por critical)
+    atomic_int parar = 0;
+
+    double inicio = omp_get_wtime();
+
+    #pragma omp parallel
+    {
+        #pragma omp for schedule(dynamic)
+        for (long long lote = 0; lote < max_lotes; lote++) {
+            if (modo == PARADA_FLAG) {
+                // Leitura relaxada: basta ver a flag "em algum momento"; os lotes já
+                // iniciados terminam e são contabilizados normalmente
+                if (atomic_load_explicit(&parar, memory_order_relaxed)) continue;
+            } else {
+                #pragma omp cancellation point for
+            }
+
+            long long acertos = kernel(SEMENTE, (uint64_t)lote, PONTOS_POR_LOTE);
+
+            int atingiu = 0;
+            #pragma omp critical(estimativa) // Uma vez por lote: custo desprezível
+            {
+                acertos_total += acertos;
+                pontos_total += PONTOS_POR_LOTE;
+                if (pontos_total >= (long long)LOTES_MINIMOS * PONTOS_POR_LOTE &&
+                    erro_padrao_pi(acertos_total, pontos_total) <= alvo) {
+                    atingiu = 1;
+                }
+            }
+
+            if (atingiu) {
+                if (modo == PARADA_FLAG) {
+                    atomic_store_explicit(&parar, 1, memory_order_relaxed);
+                } else {
+                    #pragma omp cancel for
+                }
+            }
+        }
+    }
+
+    ResultadoAdaptativo r;
+    r.tempo = omp_get_wtime() - inicio;
+    r.pontos = pontos_total;
+    r.pi = 4.0 * acertos_total / pontos_total;
+    r.erro_padrao = erro_padrao_pi(acertos_total, pontos_total);
+    return r;
+}
+
+// Referência: número fixo de pontos, mesmo kernel
+ResultadoAdaptativo estimar_pi_fixo(long long num_pontos) {
+    mc_kernel_fn kernel = mc_simd_kernel(mc_simd_isa_detectada());
+    long long num_lotes = num_pontos / PONTOS_POR_LOTE;
+    long long acertos_total = 0;
+
+    double inicio = omp_get_wtime();
+    #pragma omp parallel for schedule(static) reduction(+:acertos_total)
+    for (long long lote = 0; lote < num_lotes; lote++) {
+        acertos_total += kernel(SEMENTE, (uint64_t)lote, PONTOS_POR_LOTE);
+    }
+
+    ResultadoAdaptativo r;
+    r.tempo = omp_get_wtime() - inicio;
+    r.pontos = num_lotes * PONTOS_POR_LOTE;
+    r.pi = 4.0 * acertos_total / r.pontos;
+    r.erro_padrao = erro_padrao_pi(acertos_total, r.pontos);
+    return r;
+}
+
+void imprimir_resultado(const char *nome, ResultadoAdaptativo r, double tempo_fixo) {
+    char ganho[32];
+    snprintf(ganho, sizeof(ganho), "%.1fx", tempo_fixo / r.tempo);
+    printf("%-22s %-14lld %-12.8f %-12.2e %-12.2e %-10.4f %-9s\n", nome, r.pontos, r.pi,
+           r.erro_padrao, fabs(r.pi - M_PI), r.tempo, ganho);
+}
+
+int main(int argc, char *argv[]) {
+    omp_set_num_threads(4);
+
+    long long num_pontos = 250000000; // Mesmo N fixo de tarefa6
+    if (argc > 1) num_pontos = atoll(argv[1]);
+    if (num_pontos < 1) {
+        fprintf(stderr, "Uso: %s [pontos_fixos > 0]\n", argv[0]);
+        return 1;
+    }
+    // Os lotes são processados inteiros: arredonda N para cima (pelo menos um lote). O teto dos
+    // adaptativos (4 N) sai do N já arredondado, então também é um número inteiro de lotes
+    num_pontos = (num_pontos + PONTOS_POR_LOTE - 1) / PONTOS_POR_LOTE * PONTOS_POR_LOTE;
+    long long max_pontos = num_pontos * 4;
+
+    printf("=== MONTE CARLO ADAPTATIVO: PARA AO ATINGIR O ERRO-PADRÃO ALVO ===\n");
+    printf("Threads: %d | Kernel: %s | Lote: %d pontos\n", omp_get_max_threads(),
+           mc_simd_nome(mc_simd_isa_detectada()), PONTOS_POR_LOTE);
+    if (!omp_get_cancellation()) {
+        printf("Aviso: OMP_CANCELLATION não está ativo; o modo cancel não interrompe o laço.\n");
+        printf("       Execute com OMP_CANCELLATION=true ./tarefa6_adaptativo\n");
+    }
+
+    ResultadoAdaptativo fixo = estimar_pi_fixo(num_pontos);
+
+    printf("\n%-22s %-14s %-12s %-12s %-12s %-10s %-9s\n",
+           "Execução", "Pontos", "π", "Erro-padrão", "Erro real", "Tempo (s)", "Ganho");
+    imprimir_resultado("N fixo", fixo, fixo.tempo);
+
+    double alvos[] = {1e-2, 1e-3, 3e-4, fixo.erro_padrao};
+    int num_alvos = sizeof(alvos) / sizeof(alvos[0]);
+    for (int i = 0; i < num_alvos; i++) {
+        char nome[64];
+        snprintf(nome, sizeof(nome), "alvo %.1e (flag)", alvos[i]);
+        imprimir_resultado(nome, estimar_pi_adaptativo(alvos[i], max_pontos, PARADA_FLAG), fixo.tempo);
+        snprintf(nome, sizeof(nome), "alvo %.1e (cancel)", alvos[i]);
+        imprimir_resultado(nome, estimar_pi_adaptativo(alvos[i], max_pontos, PARADA_CANCEL), fixo.tempo);
+    }
+
+    return 0;
+}
+
+// Compilação: gcc -O2 -fopenmp tarefa6_adaptativo.c -o tarefa6_adaptativo -lm
+// Execução:   OMP_CANCELLATION=true ./tarefa6_adaptativo [pontos_fixos]
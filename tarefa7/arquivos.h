@@ -0,0 +1,226 @@
+#ifndef ARQUIVOS_H
+#define ARQUIVOS_H
+
+// Processamento real de arquivos para tarefa7
+//
+// - Lista de arquivos de um diretório (percorrido recursivamente), com inserção O(1) no fim
+// - Análise de um trecho de bytes: histograma, linhas ('\n') e Adler-32
+// - Combinação de trechos na ordem do arquivo: o Adler-32 de trechos consecutivos se junta
+//   com adler32_combinar, então um arquivo grande pode ser dividido em tasks independentes
+// - Gerador de conjuntos sintéticos (texto com linhas de tamanho variável) para os benchmarks
+
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <dirent.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+
+#define ADLER_BASE 65521u
+#define ADLER_NMAX 5552          // Maior n tal que as somas não estouram 32 bits
+
+typedef struct {
+    uint64_t histograma[256];
+    uint64_t bytes;
+    uint32_t adler;              // Adler-32 do trecho (valor inicial 1)
+} Analise;
+
+typedef struct Arquivo {
+    char *caminho;
+    off_t tamanho;
+    Analise resultado;
+    struct Arquivo *proximo;
+} Arquivo;
+
+typedef struct {
+    Arquivo *cabeca;
+    Arquivo *cauda;              // Inserção no fim sem percorrer a lista
+    int quantidade;
+    uint64_t bytes;
+} ListaArquivos;
+
+static inline void analise_iniciar(Analise *a) {
+    memset(a->histograma, 0, sizeof(a->histograma));
+    a->bytes = 0;
+    a->adler = 1;
+}
+
+static inline uint64_t analise_linhas(const Analise *a) {
+    return a->histograma['\n'];
+}
+
+// Acumula 'n' bytes no trecho
+static inline void analise_bytes(Analise *a, const unsigned char *buf, size_t n) {
+    // Quatro histogramas intercalados: bytes repetidos não serializam no mesmo contador.
+    // Contadores de 32 bits: descarregados a cada pedaço de até 1 GB
+    uint32_t h[4][256];
+    uint32_t s1 = a->adler & 0xFFFF, s2 = a->adler >> 16;
+    size_t i = 0;
+    while (i < n) {
+        size_t fim_pedaco = n - i < (1u << 30) ? n : i + (1u << 30);
+        memset(h, 0, sizeof(h));
+        while (i < fim_pedaco) {
+            size_t fim = fim_pedaco - i < ADLER_NMAX ? fim_pedaco : i + ADLER_NMAX;
+            size_t k = i;
+            for (; k + 4 <= fim; k += 4) {
+                h[0][buf[k]]++;
+                h[1][buf[k + 1]]++;
+                h[2][buf[k + 2]]++;
+                h[3][buf[k + 3]]++;
+                s1 += buf[k];     s2 += s1;
+                s1 += buf[k + 1]; s2 += s1;
+                s1 += buf[k + 2]; s2 += s1;
+                s1 += buf[k + 3]; s2 += s1;
+            }
+            for (; k < fim; k++) {
+                h[0][buf[k]]++;
+                s1 += buf[k];
+                s2 += s1;
+            }
+            s1 %= ADLER_BASE;   // A cada ADLER_NMAX bytes, antes de s2 estourar
+            s2 %= ADLER_BASE;
+            i = fim;
+        }
+        for (int b = 0; b < 256; b++) {
+            a->histograma[b] += (uint64_t)h[0][b] + h[1][b] + h[2][b] + h[3][b];
+        }
+    }
+    a->adler = (s2 << 16) | s1;
+    a->bytes += n;
+}
+
+// Adler-32 da concatenação A || B, sabendo só adler(A), adler(B) e len(B)
+static inline uint32_t adler32_combinar(uint32_t adler1, uint32_t adler2, uint64_t len2) {
+    uint32_t resto = (uint32_t)(len2 % ADLER_BASE);
+    uint64_t s1 = adler1 & 0xFFFF;
+    uint64_t s2 = (resto * s1) % ADLER_BASE;
+    s1 += (adler2 & 0xFFFF) + ADLER_BASE - 1;
+    s2 += (adler1 >> 16) + (adler2 >> 16) + ADLER_BASE - resto;
+    if (s1 >= ADLER_BASE) s1 -= ADLER_BASE;
+    if (s1 >= ADLER_BASE) s1 -= ADLER_BASE;
+    if (s2 >= 2ull * ADLER_BASE) s2 -= 2ull * ADLER_BASE;
+    if (s2 >= ADLER_BASE) s2 -= ADLER_BASE;
+    return (uint32_t)(s1 | (s2 << 16));
+}
+
+// destino = destino || trecho (o trecho vem logo depois no arquivo)
+static inline void analise_combinar(Analise *destino, const Analise *trecho) {
+    for (int b = 0; b < 256; b++) destino->histograma[b] += trecho->histograma[b];
+    destino->adler = adler32_combinar(destino->adler, trecho->adler, trecho->bytes);
+    destino->bytes += trecho->bytes;
+}
+
+// Lê [inicio, inicio + n) com pread em pedaços de 'tam_buffer' bytes
+static inline int analise_pread(Analise *a, int fd, off_t inicio, size_t n, unsigned char *buffer, size_t tam_buffer) {
+    while (n > 0) {
+        size_t pedir = n < tam_buffer ? n : tam_buffer;
+        ssize_t lidos = pread(fd, buffer, pedir, inicio);
+        if (lidos < 0 && errno == EINTR) continue;
+        if (lidos <= 0) return -1;
+        analise_bytes(a, buffer, (size_t)lidos);
+        inicio += lidos;
+        n -= (size_t)lidos;
+    }
+    return 0;
+}
+
+// ---------------------------------------------------------------------------
+// Lista de arquivos
+// ---------------------------------------------------------------------------
+static inline void lista_iniciar(ListaArquivos *l) {
+    l->cabeca = l->cauda = NULL;
+    l->quantidade = 0;
+    l->bytes = 0;
+}
+
+static inline void lista_adicionar(ListaArquivos *l, const char *caminho, off_t tamanho) {
+    Arquivo *a = malloc(sizeof(Arquivo));
+    if (a == NULL || (a->caminho = strdup(caminho)) == NULL) {
+        fprintf(stderr, "Erro ao alocar memória para a lista de arquivos\n");
+        exit(1);
+    }
+    a->tamanho = tamanho;
+    a->proximo = NULL;
+    analise_iniciar(&a->resultado);
+    if (l->cauda == NULL) l->cabeca = a;
+    else l->cauda->proximo = a;
+    l->cauda = a;
+    l->quantidade++;
+    l->bytes += tamanho;
+}
+
+// Percorre 'diretorio' recursivamente, adicionando os arquivos regulares
+static inline int lista_diretorio(ListaArquivos *l, const char *diretorio) {
+    DIR *d = opendir(diretorio);
+    if (d == NULL) {
+        perror(diretorio);
+        return -1;
+    }
+    struct dirent *e;
+    char caminho[4096];
+    while ((e = readdir(d)) != NULL) {
+        if (strcmp(e->d_name, ".") == 0 || strcmp(e->d_name, "..") == 0) continue;
+        snprintf(caminho, sizeof(caminho), "%s/%s", diretorio, e->d_name);
+        struct stat st;
+        if (lstat(caminho, &st) != 0) continue;            // Links simbólicos não são seguidos
+        if (S_ISDIR(st.st_mode)) lista_diretorio(l, caminho);
+        else if (S_ISREG(st.st_mode)) lista_adicionar(l, caminho, st.st_size);
+    }
+    closedir(d);
+    return 0;
+}
+
+static inline void lista_liberar(ListaArquivos *l) {
+    Arquivo *a = l->cabeca;
+    while (a != NULL) {
+        Arquivo *prox = a->proximo;
+        free(a->caminho);
+        free(a);
+        a = prox;
+    }
+    lista_iniciar(l);
+}
+
+// ---------------------------------------------------------------------------
+// Conjuntos sintéticos: 'num' arquivos de 'tamanho' bytes em diretorio/prefixo_i.txt
+// ---------------------------------------------------------------------------
+static inline int gerar_conjunto(const char *diretorio, const char *prefixo, int num, size_t tamanho) {
+    if (mkdir(diretorio, 0755) != 0 && errno != EEXIST) {
+        perror(diretorio);
+        return -1;
+    }
+    char *buffer = malloc(tamanho > 0 ? tamanho : 1);
+    if (buffer == NULL) {
+        fprintf(stderr, "Erro ao alocar memória para o gerador\n");
+        exit(1);
+    }
+    char caminho[4096];
+    for (int i = 0; i < num; i++) {
+        snprintf(caminho, sizeof(caminho), "%s/%s_%05d.txt", diretorio, prefixo, i);
+        struct stat st;
+        if (stat(caminho, &st) == 0 && (size_t)st.st_size == tamanho) continue; // Já existe
+        uint64_t x = 0x9E3779B97F4A7C15ULL * (i + 1) + tamanho;
+        for (size_t k = 0; k < tamanho; k++) {
+            x ^= x << 13; x ^= x >> 7; x ^= x << 17;
+            int r = (int)(x % 64);
+            buffer[k] = r < 2 ? '\n' : (r < 10 ? ' ' : (char)('a' + r % 26)); // Linhas de ~32 bytes
+        }
+        FILE *f = fopen(caminho, "wb");
+        if (f == NULL) {
+            perror(caminho);
+            free(buffer);
+            return -1;
+        }
+        fwrite(buffer, 1, tamanho, f);
+        fclose(f);
+    }
+    free(buffer);
+    return 0;
+}
+
+#endif // ARQUIVOS_H
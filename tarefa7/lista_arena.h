@@ -0,0 +1,116 @@
+#ifndef LISTA_ARENA_H
+#define LISTA_ARENA_H
+
+// Lista de nomes de arquivos em arena
+//
+// - Nós alocados em slabs contíguos (64 nós no primeiro, dobrando até 64K): o percurso
+//   segue 'proximo', mas na prática anda para a frente na memória e o prefetch acompanha
+// - Nomes copiados para um pool de texto (blocos de 64 KB), sem buffer fixo por nó
+// - Inserção no fim em O(1) com ponteiro de cauda
+// - Liberação de tudo em uma chamada: um free por slab e por bloco de texto, não por nó
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define ARENA_SLAB_INICIAL 64
+#define ARENA_SLAB_MAXIMO 65536
+#define ARENA_BLOCO_TEXTO 65536
+
+typedef struct NoArena {
+    const char *nome;            // Aponta para o pool de texto
+    struct NoArena *proximo;
+} NoArena;
+
+typedef struct Slab {
+    struct Slab *anterior;
+    size_t usados;
+    size_t capacidade;
+    NoArena nos[];
+} Slab;
+
+typedef struct BlocoTexto {
+    struct BlocoTexto *anterior;
+    size_t usados;
+    size_t capacidade;
+    char dados[];
+} BlocoTexto;
+
+typedef struct {
+    NoArena *cabeca;
+    NoArena *cauda;
+    long quantidade;
+    Slab *slab;                  // Slab atual (os anteriores ficam encadeados)
+    BlocoTexto *texto;           // Bloco de texto atual
+} ListaArena;
+
+static inline void lista_arena_iniciar(ListaArena *l) {
+    l->cabeca = l->cauda = NULL;
+    l->quantidade = 0;
+    l->slab = NULL;
+    l->texto = NULL;
+}
+
+static inline void *arena_alocar(size_t bytes) {
+    void *p = malloc(bytes);
+    if (p == NULL) {
+        fprintf(stderr, "Erro ao alocar memória para a arena\n");
+        exit(1);
+    }
+    return p;
+}
+
+// Copia 'nome' para o pool de texto; nomes maiores que um bloco ganham um bloco só deles
+static inline const char *arena_copiar_texto(ListaArena *l, const char *nome) {
+    size_t n = strlen(nome) + 1;
+    BlocoTexto *b = l->texto;
+    if (b == NULL || b->capacidade - b->usados < n) {
+        size_t capacidade = n > ARENA_BLOCO_TEXTO ? n : ARENA_BLOCO_TEXTO;
+        b = arena_alocar(sizeof(BlocoTexto) + capacidade);
+        b->anterior = l->texto;
+        b->usados = 0;
+        b->capacidade = capacidade;
+        l->texto = b;
+    }
+    char *destino = b->dados + b->usados;
+    memcpy(destino, nome, n);
+    b->usados += n;
+    return destino;
+}
+
+static inline NoArena *lista_arena_adicionar(ListaArena *l, const char *nome) {
+    Slab *s = l->slab;
+    if (s == NULL || s->usados == s->capacidade) {
+        size_t capacidade = s == NULL ? ARENA_SLAB_INICIAL : s->capacidade * 2;
+        if (capacidade > ARENA_SLAB_MAXIMO) capacidade = ARENA_SLAB_MAXIMO;
+        s = arena_alocar(sizeof(Slab) + capacidade * sizeof(NoArena));
+        s->anterior = l->slab;
+        s->usados = 0;
+        s->capacidade = capacidade;
+        l->slab = s;
+    }
+    NoArena *no = &s->nos[s->usados++];
+    no->nome = arena_copiar_texto(l, nome);
+    no->proximo = NULL;
+    if (l->cauda == NULL) l->cabeca = no;
+    else l->cauda->proximo = no;
+    l->cauda = no;
+    l->quantidade++;
+    return no;
+}
+
+static inline void lista_arena_liberar(ListaArena *l) {
+    for (Slab *s = l->slab; s != NULL; ) {
+        Slab *ant = s->anterior;
+        free(s);
+        s = ant;
+    }
+    for (BlocoTexto *b = l->texto; b != NULL; ) {
+        BlocoTexto *ant = b->anterior;
+        free(b);
+        b = ant;
+    }
+    lista_arena_iniciar(l);
+}
+
+#endif // LISTA_ARENA_H
@@ -2,83 +2,49 @@
 #include <stdlib.h>
 #include <string.h>
 #include <omp.h>
-
-// Estrutura do nó da lista encadeada
-typedef struct No {
-    char nome_arquivo[50];  // Nome do arquivo a ser processado
-    struct No* proximo;     // Ponteiro para o próximo nó
-} No;
-
-// Função para criar um novo nó
-No* criar_no(const char* nome) {
-    No* novo_no = (No*)malloc(sizeof(No));  // Aloca memória para novo nó
-    if (novo_no != NULL) {
-        strcpy(novo_no->nome_arquivo, nome);  // Copia nome do arquivo
-        novo_no->proximo = NULL;              // Inicializa ponteiro como NULL
-    }
-    return novo_no;
-}
-
-// Função para adicionar um nó no final da lista
-void adicionar_no(No** cabeca, const char* nome) {
-    No* novo_no = criar_no(nome);  // Cria novo nó
-    if (*cabeca == NULL) {
-        *cabeca = novo_no;         // Se lista vazia, novo nó vira cabeça
-    } else {
-        No* atual = *cabeca;       // Percorre até o final da lista
-        while (atual->proximo != NULL) {
-            atual = atual->proximo;
-        }
-        atual->proximo = novo_no;  // Adiciona no final
-    }
-}
+#include <unistd.h>
+#include "lista_arena.h"  // Lista em arena: nós contíguos, nomes em pool, inserção O(1)
+#include "../comum/registro.h"  // Registro sem trava: um anel por thread, descarga com writev
 
 // Função para processar um arquivo (simulação)
 void processar_arquivo(const char* nome_arquivo, int thread_id, int task_id) {
-    printf("==> Task %d iniciada na Thread %d: %s\n", task_id, thread_id, nome_arquivo);
+    REGISTRAR("==> Task %d iniciada na Thread %d: %s\n", task_id, thread_id, nome_arquivo);
     
-    // Simular algum processamento - sem critical, cada thread imprime independentemente
-    printf("  -> Thread %d: Analisando conteúdo de %s...\n", thread_id, nome_arquivo);
+    // Cada thread grava no próprio anel de registro: sem disputar a trava do stdout
+    REGISTRAR("  -> Thread %d: Analisando conteúdo de %s...\n", thread_id, nome_arquivo);
     
     // Simular tempo de processamento variável
     for (volatile int i = 0; i < 1000000; i++);  // Loop vazio para simular trabalho
     
-    printf("  -> Thread %d: Processamento de %s concluído!\n", thread_id, nome_arquivo);
-    printf("==> Task %d finalizada na Thread %d\n\n", task_id, thread_id);
-}
-
-// Função para liberar a memória da lista
-void liberar_lista(No* cabeca) {
-    No* atual = cabeca;
-    while (atual != NULL) {
-        No* temp = atual;          // Guarda referência para liberar
-        atual = atual->proximo;    // Avança para próximo nó
-        free(temp);                // Libera nó atual
-    }
+    REGISTRAR("  -> Thread %d: Processamento de %s concluído!\n", thread_id, nome_arquivo);
+    REGISTRAR("==> Task %d finalizada na Thread %d\n\n", task_id, thread_id);
 }
 
 int main() {
     // Criar lista encadeada com nomes de arquivos baseados em cientistas famosos
-    No* lista_arquivos = NULL;  // Inicializa lista vazia
+    ListaArena lista_arquivos;
+    lista_arena_iniciar(&lista_arquivos);  // Inicializa lista vazia
     
     printf("=== PROCESSAMENTO PARALELO DE ARQUIVOS COM TASKS ===\n");
     printf("Criando lista de arquivos fictícios...\n\n");
     
     // Adicionar arquivos com nomes de cientistas famosos
-    adicionar_no(&lista_arquivos, "Einstein.txt");  
-    adicionar_no(&lista_arquivos, "Newton.txt");    
-    adicionar_no(&lista_arquivos, "Darwin.txt");    
-    adicionar_no(&lista_arquivos, "Curie.txt");     
-    adicionar_no(&lista_arquivos, "Tesla.txt");     
-    adicionar_no(&lista_arquivos, "Hawking.txt");   
-    adicionar_no(&lista_arquivos, "Turing.txt");    
-    adicionar_no(&lista_arquivos, "Galileo.txt");   
-    adicionar_no(&lista_arquivos, "Mendel.txt");    
-    adicionar_no(&lista_arquivos, "Pascal.txt");    
+    lista_arena_adicionar(&lista_arquivos, "Einstein.txt");  
+    lista_arena_adicionar(&lista_arquivos, "Newton.txt");    
+    lista_arena_adicionar(&lista_arquivos, "Darwin.txt");    
+    lista_arena_adicionar(&lista_arquivos, "Curie.txt");     
+    lista_arena_adicionar(&lista_arquivos, "Tesla.txt");     
+    lista_arena_adicionar(&lista_arquivos, "Hawking.txt");   
+    lista_arena_adicionar(&lista_arquivos, "Turing.txt");    
+    lista_arena_adicionar(&lista_arquivos, "Galileo.txt");   
+    lista_arena_adicionar(&lista_arquivos, "Mendel.txt");    
+    lista_arena_adicionar(&lista_arquivos, "Pascal.txt");    
 
     printf("Número de threads disponíveis: %d\n", omp_get_max_threads());
     printf("Iniciando processamento paralelo...\n\n");
     
+    REGISTRO_INICIAR(STDOUT_FILENO, 0.05);  // Linhas das threads saem pela thread de registro
+
     // Região paralela com tasks
     #pragma omp parallel
     {
@@ -87,7 +53,7 @@ int main() {
         // Master thread faz inicialização
         #pragma omp master
         {
-            printf("Thread master %d inicializando sistema...\n", thread_id);
+            REGISTRAR("Thread master %d inicializando sistema...\n", thread_id);
         }
         
         // Barrier para garantir que todas as threads estejam prontas
@@ -96,18 +62,17 @@ int main() {
         // Apenas uma thread cria as tasks (single)
         #pragma omp single
         {
-            printf("Thread %d criando tasks para processamento...\n\n", omp_get_thread_num());
+            REGISTRAR("Thread %d criando tasks para processamento...\n\n", omp_get_thread_num());
             
-            No* atual = lista_arquivos;  // Ponteiro para percorrer lista
+            NoArena* atual = lista_arquivos.cabeca;  // Ponteiro para percorrer lista
             int contador_arquivos = 0;   // Contador de tasks criadas
             
             // Percorrer a lista e criar uma task para cada nó
             while (atual != NULL) {
                 contador_arquivos++;
                 
-                // Capturar o nome do arquivo por valor para evitar race conditions
-                char nome_local[50];     // Cópia local do nome
-                strcpy(nome_local, atual->nome_arquivo);
+                // O pool de nomes só é liberado no fim: basta capturar o ponteiro
+                const char* nome_local = atual->nome;
                 int task_id = contador_arquivos;  // ID da task
                 
                 // Criar task para processar este arquivo
@@ -120,8 +85,8 @@ int main() {
                 atual = atual->proximo;  // Avança para próximo nó
             }
             
-            printf("Todas as %d tasks foram criadas!\n", contador_arquivos);
-            printf("Aguardando conclusão de todas as tasks...\n\n");
+            REGISTRAR("Todas as %d tasks foram criadas!\n", contador_arquivos);
+            REGISTRAR("Aguardando conclusão de todas as tasks...\n\n");
         }
         
         // Aguardar explicitamente todas as tasks terminarem
@@ -133,15 +98,19 @@ int main() {
         // Master thread faz finalização
         #pragma omp master
         {
-            printf("Thread master %d finalizando processamento...\n", thread_id);
+            REGISTRAR("Thread master %d finalizando processamento...\n", thread_id);
         }
     }
     
+    REGISTRO_SINCRONIZAR();  // Descarrega os registros antes de voltar ao printf
+
     printf("\n=== PROCESSAMENTO CONCLUÍDO ===\n");
     printf("Todos os arquivos foram processados com sucesso!\n");
     
+    REGISTRO_FINALIZAR();  // Para a thread de registro e libera os anéis
+
     // Liberar memória da lista
-    liberar_lista(lista_arquivos);  // Limpa toda a lista da memória
+    lista_arena_liberar(&lista_arquivos);  // Um free por slab e por bloco de texto
     
     return 0;
 }
\ No newline at end of file
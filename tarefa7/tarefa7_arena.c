@@ -0,0 +1,215 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <omp.h>
+#include "lista_arena.h"
+
+// ---------------------------------------------------------------------------
+// Lista original da tarefa7: um malloc por nó, nome em buffer fixo, inserção percorrendo a lista
+// ---------------------------------------------------------------------------
+typedef struct No {
+    char nome_arquivo[50];
+    struct No* proximo;
+} No;
+
+No* criar_no(const char* nome) {
+    No* novo_no = (No*)malloc(sizeof(No));
+    if (novo_no != NULL) {
+        strcpy(novo_no->nome_arquivo, nome);
+        novo_no->proximo = NULL;
+    }
+    return novo_no;
+}
+
+void adicionar_no(No** cabeca, const char* nome) {
+    No* novo_no = criar_no(nome);
+    if (*cabeca == NULL) {
+        *cabeca = novo_no;
+    } else {
+        No* atual = *cabeca;
+        while (atual->proximo != NULL) {
+            atual = atual->proximo;
+        }
+        atual->proximo = novo_no;
+    }
+}
+
+// Mesmos nós, mas com ponteiro de cauda: separa o custo da inserção O(n) do custo do layout
+void adicionar_no_cauda(No** cabeca, No** cauda, const char* nome) {
+    No* novo_no = criar_no(nome);
+    if (novo_no == NULL) {
+        fprintf(stderr, "Erro ao alocar memória para o nó\n");
+        exit(1);
+    }
+    if (*cauda == NULL) *cabeca = novo_no;
+    else (*cauda)->proximo = novo_no;
+    *cauda = novo_no;
+}
+
+void liberar_lista(No* cabeca) {
+    No* atual = cabeca;
+    while (atual != NULL) {
+        No* temp = atual;
+        atual = atual->proximo;
+        free(temp);
+    }
+}
+
+// ---------------------------------------------------------------------------
+// Medição
+// ---------------------------------------------------------------------------
+static inline void nome_arquivo(char* destino, long i) {
+    sprintf(destino, "arquivo_%07ld.txt", i);
+}
+
+// Percurso: hash FNV-1a de todos os nomes (lê o nó e o texto)
+static inline uint64_t hash_nome(uint64_t h, const char* c) {
+    for (; *c; c++) h = (h ^ (unsigned char)*c) * 1099511628211ULL;
+    return h;
+}
+
+uint64_t percorrer_original(No* cabeca) {
+    uint64_t h = 1469598103934665603ULL;
+    for (No* no = cabeca; no != NULL; no = no->proximo) h = hash_nome(h, no->nome_arquivo);
+    return h;
+}
+
+uint64_t percorrer_arena(ListaArena* l) {
+    uint64_t h = 1469598103934665603ULL;
+    for (NoArena* no = l->cabeca; no != NULL; no = no->proximo) h = hash_nome(h, no->nome);
+    return h;
+}
+
+// Espalha os blocos livres do heap: aloca 2n blocos do tamanho de um nó e libera metade em
+// ordem aleatória, como num programa que já rodou por um tempo. Devolve a metade que ficou.
+void** fragmentar_heap(long n) {
+    void** blocos = malloc(2 * n * sizeof(void*));
+    if (blocos == NULL) {
+        fprintf(stderr, "Erro ao alocar memória para a fragmentação\n");
+        exit(1);
+    }
+    for (long i = 0; i < 2 * n; i++) blocos[i] = malloc(sizeof(No));
+    uint64_t x = 88172645463325252ULL;
+    for (long i = 2 * n - 1; i > 0; i--) {      // Fisher-Yates
+        x ^= x << 13; x ^= x >> 7; x ^= x << 17;
+        long j = (long)(x % (uint64_t)(i + 1));
+        void* t = blocos[i]; blocos[i] = blocos[j]; blocos[j] = t;
+    }
+    for (long i = 0; i < n; i++) free(blocos[i]);
+    return blocos;
+}
+
+void imprimir_linha(const char* versao, long n, double construir, double percorrer, double liberar,
+                    double bytes_por_no, const char* hash, int estimado) {
+    char tempo_construir[32];
+    snprintf(tempo_construir, sizeof(tempo_construir), "%.4f%s", construir, estimado ? " (est.)" : "");
+    printf("%-28s %-9ld %-18s %-10.2f %-12.4f %-11.1f %-6s\n", versao, n, tempo_construir,
+           percorrer * 1e9 / n, liberar, bytes_por_no, hash);
+}
+
+int main(int argc, char* argv[]) {
+    long n = argc > 1 ? atol(argv[1]) : 1000000;
+    long n_original = argc > 2 ? atol(argv[2]) : 20000;   // O(n²): medida menor e extrapolada
+    if (n < 1) n = 1;
+    if (n_original > n) n_original = n;
+    if (n_original < 1) n_original = 1;
+    char nome[64];
+    const int passadas = 5;
+
+    printf("=== LISTA DA TAREFA7: MALLOC POR NÓ vs ARENA ===\n");
+    printf("Nós: %ld | Nó original: %zu bytes | Nó em arena: %zu bytes + nome no pool\n\n", n, sizeof(No), sizeof(NoArena));
+    printf("%-28s %-9s %-18s %-10s %-12s %-11s %-6s\n", "Versao", "Nos", "Construir (s)", "ns/no", "Liberar (s)",
+           "Bytes/no", "Hash");
+
+    // Referências: o hash de todos os nomes, calculado direto
+    uint64_t referencia = 1469598103934665603ULL, referencia_original = 0;
+    for (long i = 0; i < n; i++) {
+        if (i == n_original) referencia_original = referencia;
+        nome_arquivo(nome, i);
+        referencia = hash_nome(referencia, nome);
+    }
+    if (n_original == n) referencia_original = referencia;
+    // glibc: 8 bytes de cabeçalho, bloco arredondado para múltiplo de 16
+    double bytes_malloc = (double)((sizeof(No) + 8 + 15) & ~(size_t)15);
+
+    // 1. Código original: mede com n_original nós e extrapola para n (custo quadrático)
+    {
+        No* lista = NULL;
+        double inicio = omp_get_wtime();
+        for (long i = 0; i < n_original; i++) {
+            nome_arquivo(nome, i);
+            adicionar_no(&lista, nome);
+        }
+        double construir = omp_get_wtime() - inicio;
+        double escala = (double)n / n_original;
+        uint64_t h = 0;
+        inicio = omp_get_wtime();
+        for (int p = 0; p < passadas; p++) h = percorrer_original(lista);
+        double percorrer = (omp_get_wtime() - inicio) / passadas;
+        inicio = omp_get_wtime();
+        liberar_lista(lista);
+        double liberar = omp_get_wtime() - inicio;
+        imprimir_linha("Original (adicionar_no)", n_original, construir, percorrer, liberar, bytes_malloc,
+                       h == referencia_original ? "ok" : "ERRO", 0);
+        if (n_original < n) {
+            imprimir_linha("Original extrapolado", n, construir * escala * escala, percorrer * escala,
+                           liberar * escala, bytes_malloc, "-", 1);
+        }
+    }
+
+    // 2. malloc por nó com cauda, heap recém-iniciado e heap fragmentado
+    for (int fragmentado = 0; fragmentado <= 1; fragmentado++) {
+        void** sobras = fragmentado ? fragmentar_heap(n) : NULL;
+        No *lista = NULL, *cauda = NULL;
+        double inicio = omp_get_wtime();
+        for (long i = 0; i < n; i++) {
+            nome_arquivo(nome, i);
+            adicionar_no_cauda(&lista, &cauda, nome);
+        }
+        double construir = omp_get_wtime() - inicio;
+        uint64_t h = 0;
+        inicio = omp_get_wtime();
+        for (int p = 0; p < passadas; p++) h = percorrer_original(lista);
+        double percorrer = (omp_get_wtime() - inicio) / passadas;
+        inicio = omp_get_wtime();
+        liberar_lista(lista);
+        double liberar = omp_get_wtime() - inicio;
+        imprimir_linha(fragmentado ? "malloc + cauda (fragmentado)" : "malloc + cauda", n, construir, percorrer,
+                       liberar, bytes_malloc, h == referencia ? "ok" : "ERRO", 0);
+        if (sobras != NULL) {
+            for (long i = n; i < 2 * n; i++) free(sobras[i]);
+            free(sobras);
+        }
+    }
+
+    // 3. Arena
+    {
+        ListaArena lista;
+        lista_arena_iniciar(&lista);
+        double inicio = omp_get_wtime();
+        for (long i = 0; i < n; i++) {
+            nome_arquivo(nome, i);
+            lista_arena_adicionar(&lista, nome);
+        }
+        double construir = omp_get_wtime() - inicio;
+        uint64_t h = 0;
+        inicio = omp_get_wtime();
+        for (int p = 0; p < passadas; p++) h = percorrer_arena(&lista);
+        double percorrer = (omp_get_wtime() - inicio) / passadas;
+        double bytes = 0;
+        for (Slab* s = lista.slab; s != NULL; s = s->anterior) bytes += sizeof(Slab) + s->capacidade * sizeof(NoArena);
+        for (BlocoTexto* b = lista.texto; b != NULL; b = b->anterior) bytes += sizeof(BlocoTexto) + b->capacidade;
+        inicio = omp_get_wtime();
+        lista_arena_liberar(&lista);
+        double liberar = omp_get_wtime() - inicio;
+        imprimir_linha("Arena", n, construir, percorrer, liberar, bytes / n, h == referencia ? "ok" : "ERRO", 0);
+    }
+
+    printf("\n'Construir' inclui gerar o nome; ns/no é o percurso (média de %d passadas).\n", passadas);
+    printf("Bytes/no do malloc contam o cabeçalho e o arredondamento do alocador (glibc).\n");
+    return 0;
+}
+
+// Compilação: gcc -O2 -fopenmp tarefa7_arena.c -o tarefa7_arena
+// Execução:   ./tarefa7_arena [nos] [nos_versao_original]
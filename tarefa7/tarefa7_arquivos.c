@@ -0,0 +1,268 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdatomic.h>
+#include <omp.h>
+#include <sys/mman.h>
+#include <sys/resource.h>
+#include "arquivos.h"
+
+#define TAMANHO_TRECHO (4 << 20)    // Arquivos maiores que isso viram uma task por trecho
+#define TAMANHO_BUFFER (1 << 20)    // Buffer de pread por thread
+#define DIRETORIO_PADRAO "/tmp/tarefa7_dados"
+#define MAX_GRANDES_ABERTOS 64     // Arquivos grandes abertos ao mesmo tempo (limite de descritores)
+
+#define MODO_MMAP 0
+#define MODO_PREAD 1
+
+// Estado de um arquivo grande durante o processamento: descritor, mapa e um resultado por trecho.
+// A task do último trecho (faltando chega a zero) combina os trechos e fecha o arquivo
+typedef struct {
+    int fd;
+    unsigned char *mapa;
+    int num_trechos;
+    atomic_int faltando;
+    Analise *trechos;
+} Divisao;
+
+// Analisa o intervalo [inicio, inicio + n) de um arquivo já aberto
+void analisar_intervalo(Analise *a, int fd, const unsigned char *mapa, off_t inicio, size_t n,
+                        int modo, unsigned char *buffer) {
+    if (modo == MODO_MMAP) analise_bytes(a, mapa + inicio, n);
+    else if (analise_pread(a, fd, inicio, n, buffer, TAMANHO_BUFFER) != 0) perror("pread");
+}
+
+int abrir_arquivo(Arquivo *arq, int modo, unsigned char **mapa) {
+    int fd = open(arq->caminho, O_RDONLY);
+    if (fd < 0) {
+        perror(arq->caminho);
+        return -1;
+    }
+    *mapa = NULL;
+    if (modo == MODO_MMAP && arq->tamanho > 0) {
+        void *m = mmap(NULL, arq->tamanho, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (m == MAP_FAILED) {
+            perror("mmap");
+            close(fd);
+            return -1;
+        }
+        madvise(m, arq->tamanho, MADV_SEQUENTIAL);
+        *mapa = m;
+    }
+    return fd;
+}
+
+void fechar_arquivo(Arquivo *arq, int fd, unsigned char *mapa) {
+    if (mapa != NULL) munmap(mapa, arq->tamanho);
+    if (fd >= 0) close(fd);
+}
+
+// Arquivo pequeno: uma task faz tudo (open, leitura, análise, close); devolve -1 se não abriu
+int processar_arquivo(Arquivo *arq, int modo, unsigned char *buffer) {
+    unsigned char *mapa;
+    analise_iniciar(&arq->resultado);
+    int fd = abrir_arquivo(arq, modo, &mapa);
+    if (fd < 0) return -1;
+    analisar_intervalo(&arq->resultado, fd, mapa, 0, arq->tamanho, modo, buffer);
+    fechar_arquivo(arq, fd, mapa);
+    return 0;
+}
+
+// Último trecho de um arquivo grande: junta os trechos na ordem do arquivo (Adler-32 depende
+// da ordem) e fecha o arquivo
+void finalizar_divisao(Arquivo *arq, Divisao *d) {
+    analise_iniciar(&arq->resultado);
+    for (int c = 0; c < d->num_trechos; c++) analise_combinar(&arq->resultado, &d->trechos[c]);
+    fechar_arquivo(arq, d->fd, d->mapa);
+    free(d->trechos);
+    d->trechos = NULL;
+}
+
+// Processa a lista com tasks: granularidade definida pelo tamanho de cada arquivo.
+// Devolve o tempo; em *falhas, os arquivos que não puderam ser abertos (resultado zerado)
+double processar_lista(ListaArquivos *lista, int nthreads, int modo, int *falhas) {
+    Divisao *divisoes = calloc(lista->quantidade, sizeof(Divisao));
+    unsigned char **buffers = calloc(nthreads, sizeof(unsigned char *));
+    if (divisoes == NULL || buffers == NULL) {
+        fprintf(stderr, "Erro ao alocar memória para o processamento\n");
+        exit(1);
+    }
+    for (int t = 0; t < nthreads && modo == MODO_PREAD; t++) {
+        buffers[t] = malloc(TAMANHO_BUFFER);
+        if (buffers[t] == NULL) {
+            fprintf(stderr, "Erro ao alocar buffer de leitura\n");
+            exit(1);
+        }
+    }
+
+    // Teto de grandes abertos: MAX_GRANDES_ABERTOS, ou um quarto do limite de descritores se menor
+    int max_abertos = MAX_GRANDES_ABERTOS;
+    struct rlimit rl;
+    if (getrlimit(RLIMIT_NOFILE, &rl) == 0 && rl.rlim_cur != RLIM_INFINITY && rl.rlim_cur / 4 < (rlim_t)max_abertos) {
+        max_abertos = rl.rlim_cur / 4 > 1 ? (int)(rl.rlim_cur / 4) : 1;
+    }
+    atomic_int nao_abertos = 0;
+    double inicio = omp_get_wtime();
+    #pragma omp parallel num_threads(nthreads)
+    {
+        #pragma omp single
+        {
+            int indice = 0, grandes_abertos = 0;
+            for (Arquivo *arq = lista->cabeca; arq != NULL; arq = arq->proximo, indice++) {
+                if (arq->tamanho <= TAMANHO_TRECHO) {
+                    #pragma omp task firstprivate(arq)
+                    {
+                        if (processar_arquivo(arq, modo, buffers[omp_get_thread_num()]) != 0) {
+                            atomic_fetch_add(&nao_abertos, 1);
+                        }
+                    }
+                    continue;
+                }
+
+                // Os grandes ficam abertos até o último trecho: a cada max_abertos, espera as
+                // tasks já criadas terminarem (e fecharem os arquivos) antes de abrir mais
+                if (grandes_abertos == max_abertos) {
+                    #pragma omp taskwait
+                    grandes_abertos = 0;
+                }
+
+                // Arquivo grande: aberto aqui, uma task por trecho de TAMANHO_TRECHO bytes
+                Divisao *d = &divisoes[indice];
+                analise_iniciar(&arq->resultado);
+                d->fd = abrir_arquivo(arq, modo, &d->mapa);
+                if (d->fd < 0) {
+                    atomic_fetch_add(&nao_abertos, 1);
+                    continue;
+                }
+                grandes_abertos++;
+                d->num_trechos = (int)((arq->tamanho + TAMANHO_TRECHO - 1) / TAMANHO_TRECHO);
+                atomic_init(&d->faltando, d->num_trechos);
+                d->trechos = malloc(d->num_trechos * sizeof(Analise));
+                if (d->trechos == NULL) {
+                    fprintf(stderr, "Erro ao alocar memória para os trechos\n");
+                    exit(1);
+                }
+                for (int c = 0; c < d->num_trechos; c++) {
+                    #pragma omp task firstprivate(arq, d, c)
+                    {
+                        off_t pos = (off_t)c * TAMANHO_TRECHO;
+                        size_t n = arq->tamanho - pos < TAMANHO_TRECHO ? (size_t)(arq->tamanho - pos) : TAMANHO_TRECHO;
+                        analise_iniciar(&d->trechos[c]);
+                        analisar_intervalo(&d->trechos[c], d->fd, d->mapa, pos, n, modo,
+                                           buffers[omp_get_thread_num()]);
+                        // acq_rel: quem chega a zero vê os trechos escritos pelas outras tasks
+                        if (atomic_fetch_sub_explicit(&d->faltando, 1, memory_order_acq_rel) == 1) {
+                            finalizar_divisao(arq, d);
+                        }
+                    }
+                }
+            }
+        }
+    }
+    double tempo = omp_get_wtime() - inicio;
+    *falhas = atomic_load(&nao_abertos);
+
+    for (int t = 0; t < nthreads; t++) free(buffers[t]);
+    free(buffers);
+    free(divisoes);
+    return tempo;
+}
+
+// Resumo da lista inteira: serve para conferir que todas as execuções deram o mesmo resultado
+uint64_t resumo_lista(ListaArquivos *lista, uint64_t *linhas) {
+    uint64_t h = 1469598103934665603ULL;
+    *linhas = 0;
+    for (Arquivo *arq = lista->cabeca; arq != NULL; arq = arq->proximo) {
+        *linhas += analise_linhas(&arq->resultado);
+        h = (h ^ arq->resultado.adler) * 1099511628211ULL;
+    }
+    return h;
+}
+
+// Tabela de MB/s por número de threads e modo de leitura
+void medir_escalabilidade(ListaArquivos *lista, const char *descricao) {
+    int max_threads = omp_get_max_threads();
+    uint64_t linhas, referencia;
+    int falhas;
+    processar_lista(lista, max_threads, MODO_PREAD, &falhas); // Aquece o cache de páginas
+    referencia = resumo_lista(lista, &linhas);
+
+    printf("\n%s: %d arquivos, %.1f MB, %llu linhas\n", descricao, lista->quantidade,
+           lista->bytes / 1e6, (unsigned long long)linhas);
+    printf("%-8s %-7s %-10s %-10s %-12s %-10s\n", "Threads", "Modo", "Tempo (s)", "MB/s", "Arquivos/s", "Resultado");
+    for (int t = 1; ; t = (t * 2 < max_threads) ? t * 2 : max_threads) {
+        for (int modo = MODO_MMAP; modo <= MODO_PREAD; modo++) {
+            double tempo = processar_lista(lista, t, modo, &falhas);
+            uint64_t l;
+            int igual = resumo_lista(lista, &l) == referencia;
+            char resultado[32];
+            if (falhas > 0) snprintf(resultado, sizeof(resultado), "%d FALHAS", falhas);
+            else snprintf(resultado, sizeof(resultado), "%s", igual ? "ok" : "DIFERENTE");
+            printf("%-8d %-7s %-10.4f %-10.1f %-12.0f %-10s\n", t, modo == MODO_MMAP ? "mmap" : "pread",
+                   tempo, lista->bytes / tempo / 1e6, lista->quantidade / tempo, resultado);
+        }
+        if (t == max_threads) break;
+    }
+}
+
+int main(int argc, char *argv[]) {
+    printf("=== PROCESSAMENTO PARALELO DE ARQUIVOS REAIS COM TASKS ===\n");
+    printf("Threads disponíveis: %d | Trecho por task: %d MB\n", omp_get_max_threads(), TAMANHO_TRECHO >> 20);
+
+    if (argc > 1) {
+        // Diretório real: resultados por arquivo e escalabilidade
+        ListaArquivos lista;
+        lista_iniciar(&lista);
+        if (lista_diretorio(&lista, argv[1]) != 0) return 1;
+        int falhas;
+        processar_lista(&lista, omp_get_max_threads(), MODO_MMAP, &falhas);
+        if (falhas > 0) {
+            fprintf(stderr, "Aviso: %d de %d arquivos não puderam ser abertos (resultado zerado)\n", falhas,
+                    lista.quantidade);
+        }
+
+        printf("\n%-50s %-12s %-10s %-10s %-6s\n", "Arquivo", "Bytes", "Linhas", "Adler-32", "Byte+");
+        int mostrados = 0;
+        for (Arquivo *arq = lista.cabeca; arq != NULL && mostrados < 20; arq = arq->proximo, mostrados++) {
+            int mais_frequente = 0;
+            for (int b = 1; b < 256; b++) {
+                if (arq->resultado.histograma[b] > arq->resultado.histograma[mais_frequente]) mais_frequente = b;
+            }
+            printf("%-50.50s %-12lld %-10llu %08x   0x%02x\n", arq->caminho, (long long)arq->tamanho,
+                   (unsigned long long)analise_linhas(&arq->resultado), arq->resultado.adler, mais_frequente);
+        }
+        if (lista.quantidade > mostrados) printf("... (%d arquivos no total)\n", lista.quantidade);
+
+        medir_escalabilidade(&lista, argv[1]);
+        lista_liberar(&lista);
+        return 0;
+    }
+
+    // Sem argumento: conjuntos sintéticos com o mesmo volume total e tamanhos diferentes
+    const char *base = DIRETORIO_PADRAO;
+    struct { const char *nome; int num; size_t tamanho; } conjuntos[] = {
+        {"pequenos", 8192, 4 << 10},    // Dominado por open/close: uma task por arquivo
+        {"medios", 32, 1 << 20},        // Uma task por arquivo
+        {"grandes", 2, 16 << 20},       // 4 tasks por arquivo
+    };
+    mkdir(base, 0755);
+    for (int i = 0; i < 3; i++) {
+        char dir[512];
+        snprintf(dir, sizeof(dir), "%s/%s", base, conjuntos[i].nome);
+        if (gerar_conjunto(dir, conjuntos[i].nome, conjuntos[i].num, conjuntos[i].tamanho) != 0) return 1;
+
+        ListaArquivos lista;
+        lista_iniciar(&lista);
+        lista_diretorio(&lista, dir);
+        char descricao[128];
+        snprintf(descricao, sizeof(descricao), "Conjunto '%s' (%zu KB por arquivo)", conjuntos[i].nome,
+                 conjuntos[i].tamanho >> 10);
+        medir_escalabilidade(&lista, descricao);
+        lista_liberar(&lista);
+    }
+    printf("\nDados sintéticos em %s (podem ser apagados)\n", base);
+    return 0;
+}
+
+// Compilação: gcc -O2 -fopenmp tarefa7_arquivos.c -o tarefa7_arquivos
+// Execução:   ./tarefa7_arquivos [diretorio]
@@ -0,0 +1,285 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <omp.h>
+#include "arquivos.h"
+#include "../comum/pipeline.h"
+
+#define TAMANHO_BLOCO (1 << 20)     // Arquivos maiores são lidos em blocos de 1 MB
+#define DIRETORIO_PADRAO "/tmp/tarefa7_dados"
+#define ARQUIVO_SAIDA "/tmp/tarefa7_pipeline.txt"
+#define CAPACIDADE_FILA 64          // Lotes por fila
+#define ITENS_POR_LOTE 16
+
+// Um bloco de um arquivo: unidade que anda entre ler e analisar
+typedef struct {
+    Arquivo *arq;
+    int indice_arquivo;
+    off_t inicio;
+    size_t n;
+    unsigned char *dados;          // Alocado em 'ler', liberado em 'analisar'
+    Analise analise;
+} Bloco;
+
+typedef struct {
+    Arquivo **arquivos;
+    int num_arquivos;
+    Bloco *blocos;
+    long num_blocos;
+    int *primeiro_bloco;           // Índice do primeiro bloco de cada arquivo
+    int *blocos_por_arquivo;
+    atomic_int *blocos_faltando;   // Quando chega a zero, o arquivo pode ser combinado
+    atomic_long proximo_bloco;     // Cursor compartilhado pelas threads de 'ler'
+    FILE *saida;
+} Contexto;
+
+// Estágio 1 (E/S): lê o próximo bloco com pread
+int estagio_ler(void *item, PipeSaida *saida, void *arg) {
+    (void)item;
+    Contexto *ctx = arg;
+    long i = atomic_fetch_add(&ctx->proximo_bloco, 1);
+    if (i >= ctx->num_blocos) return 0;
+    Bloco *b = &ctx->blocos[i];
+    b->dados = malloc(b->n > 0 ? b->n : 1);
+    if (b->dados == NULL) {
+        fprintf(stderr, "Erro ao alocar memória para o bloco\n");
+        exit(1);
+    }
+    int fd = open(b->arq->caminho, O_RDONLY);
+    if (fd < 0) {
+        perror(b->arq->caminho);
+        b->n = 0;
+    } else {
+        size_t lidos = 0;
+        while (lidos < b->n) {
+            ssize_t r = pread(fd, b->dados + lidos, b->n - lidos, b->inicio + lidos);
+            if (r < 0 && errno == EINTR) continue;
+            if (r <= 0) break;
+            lidos += (size_t)r;
+        }
+        b->n = lidos;
+        close(fd);
+    }
+    pipe_emitir(saida, b);
+    return 1;
+}
+
+// Estágio 2 (CPU): histograma, linhas e Adler-32 do bloco
+int estagio_analisar(void *item, PipeSaida *saida, void *arg) {
+    (void)arg;
+    Bloco *b = item;
+    analise_iniciar(&b->analise);
+    analise_bytes(&b->analise, b->dados, b->n);
+    free(b->dados);
+    b->dados = NULL;
+    pipe_emitir(saida, b);
+    return 1;
+}
+
+// Estágio 3: quem recebe o último bloco de um arquivo junta os blocos na ordem
+int estagio_combinar(void *item, PipeSaida *saida, void *arg) {
+    Contexto *ctx = arg;
+    Bloco *b = item;
+    int a = b->indice_arquivo;
+    if (atomic_fetch_sub(&ctx->blocos_faltando[a], 1) != 1) return 1;
+    Arquivo *arq = ctx->arquivos[a];
+    analise_iniciar(&arq->resultado);
+    for (int c = 0; c < ctx->blocos_por_arquivo[a]; c++) {
+        analise_combinar(&arq->resultado, &ctx->blocos[ctx->primeiro_bloco[a] + c].analise);
+    }
+    pipe_emitir(saida, arq);
+    return 1;
+}
+
+// Estágio 4 (E/S): uma linha por arquivo no relatório
+int estagio_escrever(void *item, PipeSaida *saida, void *arg) {
+    (void)saida;
+    Contexto *ctx = arg;
+    Arquivo *arq = item;
+    fprintf(ctx->saida, "%s %lld %llu %08x\n", arq->caminho, (long long)arq->tamanho,
+            (unsigned long long)analise_linhas(&arq->resultado), arq->resultado.adler);
+    return 1;
+}
+
+// Divide os arquivos da lista em blocos
+void preparar_contexto(Contexto *ctx, ListaArquivos *lista) {
+    ctx->num_arquivos = lista->quantidade;
+    ctx->arquivos = malloc(lista->quantidade * sizeof(Arquivo *));
+    ctx->primeiro_bloco = malloc(lista->quantidade * sizeof(int));
+    ctx->blocos_por_arquivo = malloc(lista->quantidade * sizeof(int));
+    ctx->blocos_faltando = malloc(lista->quantidade * sizeof(atomic_int));
+    if (ctx->arquivos == NULL || ctx->primeiro_bloco == NULL || ctx->blocos_por_arquivo == NULL ||
+        ctx->blocos_faltando == NULL) {
+        fprintf(stderr, "Erro ao alocar memória para o contexto\n");
+        exit(1);
+    }
+    long total = 0;
+    int a = 0;
+    for (Arquivo *arq = lista->cabeca; arq != NULL; arq = arq->proximo, a++) {
+        ctx->arquivos[a] = arq;
+        ctx->primeiro_bloco[a] = (int)total;
+        ctx->blocos_por_arquivo[a] = arq->tamanho > 0 ? (int)((arq->tamanho + TAMANHO_BLOCO - 1) / TAMANHO_BLOCO) : 1;
+        total += ctx->blocos_por_arquivo[a];
+    }
+    ctx->num_blocos = total;
+    ctx->blocos = malloc(total * sizeof(Bloco));
+    if (ctx->blocos == NULL) {
+        fprintf(stderr, "Erro ao alocar memória para os blocos\n");
+        exit(1);
+    }
+    for (a = 0; a < ctx->num_arquivos; a++) {
+        Arquivo *arq = ctx->arquivos[a];
+        for (int c = 0; c < ctx->blocos_por_arquivo[a]; c++) {
+            Bloco *b = &ctx->blocos[ctx->primeiro_bloco[a] + c];
+            b->arq = arq;
+            b->indice_arquivo = a;
+            b->inicio = (off_t)c * TAMANHO_BLOCO;
+            b->n = arq->tamanho - b->inicio < TAMANHO_BLOCO ? (size_t)(arq->tamanho - b->inicio) : TAMANHO_BLOCO;
+            b->dados = NULL;
+        }
+    }
+}
+
+void reiniciar_contexto(Contexto *ctx) {
+    for (int a = 0; a < ctx->num_arquivos; a++) {
+        atomic_init(&ctx->blocos_faltando[a], ctx->blocos_por_arquivo[a]);
+        analise_iniciar(&ctx->arquivos[a]->resultado);
+    }
+    for (long i = 0; i < ctx->num_blocos; i++) {
+        Arquivo *arq = ctx->blocos[i].arq;
+        off_t inicio = ctx->blocos[i].inicio;
+        ctx->blocos[i].n = arq->tamanho - inicio < TAMANHO_BLOCO ? (size_t)(arq->tamanho - inicio) : TAMANHO_BLOCO;
+    }
+    atomic_init(&ctx->proximo_bloco, 0);
+}
+
+void liberar_contexto(Contexto *ctx) {
+    free(ctx->arquivos);
+    free(ctx->primeiro_bloco);
+    free(ctx->blocos_por_arquivo);
+    free(ctx->blocos_faltando);
+    free(ctx->blocos);
+}
+
+// Mesmo resumo de tarefa7_arquivos.c: confere o resultado contra a versão sequencial
+uint64_t resumo_lista(ListaArquivos *lista) {
+    uint64_t h = 1469598103934665603ULL;
+    for (Arquivo *arq = lista->cabeca; arq != NULL; arq = arq->proximo) {
+        h = (h ^ arq->resultado.adler) * 1099511628211ULL;
+        h = (h ^ analise_linhas(&arq->resultado)) * 1099511628211ULL;
+    }
+    return h;
+}
+
+double processar_sequencial(ListaArquivos *lista) {
+    unsigned char *buffer = malloc(TAMANHO_BLOCO);
+    if (buffer == NULL) {
+        fprintf(stderr, "Erro ao alocar buffer de leitura\n");
+        exit(1);
+    }
+    double inicio = omp_get_wtime();
+    for (Arquivo *arq = lista->cabeca; arq != NULL; arq = arq->proximo) {
+        analise_iniciar(&arq->resultado);
+        int fd = open(arq->caminho, O_RDONLY);
+        if (fd < 0) {
+            perror(arq->caminho);
+            continue;
+        }
+        if (analise_pread(&arq->resultado, fd, 0, arq->tamanho, buffer, TAMANHO_BLOCO) != 0) perror("pread");
+        close(fd);
+    }
+    double tempo = omp_get_wtime() - inicio;
+    free(buffer);
+    return tempo;
+}
+
+void medir_pipeline(ListaArquivos *lista, const char *descricao, int threads[4]) {
+    double tempo_seq = processar_sequencial(lista);   // Também aquece o cache de páginas
+    tempo_seq = processar_sequencial(lista);
+    uint64_t referencia = resumo_lista(lista);
+
+    Contexto ctx;
+    preparar_contexto(&ctx, lista);
+    reiniciar_contexto(&ctx);
+    ctx.saida = fopen(ARQUIVO_SAIDA, "w");
+    if (ctx.saida == NULL) {
+        perror(ARQUIVO_SAIDA);
+        exit(1);
+    }
+
+    PipeEstagio estagios[] = {
+        {.nome = "ler", .threads = threads[0], .funcao = estagio_ler, .arg = &ctx},
+        {.nome = "analisar", .threads = threads[1], .funcao = estagio_analisar, .arg = &ctx},
+        {.nome = "combinar", .threads = threads[2], .funcao = estagio_combinar, .arg = &ctx},
+        {.nome = "escrever", .threads = threads[3], .funcao = estagio_escrever, .arg = &ctx},
+    };
+    Pipeline p;
+    pipe_criar(&p, estagios, 4, CAPACIDADE_FILA, ITENS_POR_LOTE);
+    double tempo = pipe_executar(&p);
+    fclose(ctx.saida);
+
+    printf("\n%s: %d arquivos, %ld blocos, %.1f MB\n", descricao, lista->quantidade, ctx.num_blocos, lista->bytes / 1e6);
+    printf("Sequencial: %.4f s (%.1f MB/s) | Pipeline: %.4f s (%.1f MB/s, %.2fx) | Resultado: %s\n", tempo_seq,
+           lista->bytes / tempo_seq / 1e6, tempo, lista->bytes / tempo / 1e6, tempo_seq / tempo,
+           resumo_lista(lista) == referencia ? "ok" : "DIFERENTE");
+    pipe_relatorio(&p, tempo);
+
+    pipe_destruir(&p);
+    liberar_contexto(&ctx);
+}
+
+// "2,4,1,1" -> threads de ler, analisar, combinar e escrever
+int ler_threads(const char *texto, int threads[4]) {
+    return sscanf(texto, "%d,%d,%d,%d", &threads[0], &threads[1], &threads[2], &threads[3]) == 4;
+}
+
+int main(int argc, char *argv[]) {
+    int max_threads = omp_get_max_threads();
+    int threads[4] = {2, max_threads > 2 ? max_threads - 2 : 1, 1, 1};
+    if (argc > 1 && !ler_threads(argv[1], threads)) {
+        fprintf(stderr, "Uso: %s [ler,analisar,combinar,escrever] [diretorio]\n", argv[0]);
+        return 1;
+    }
+
+    printf("=== PIPELINE LER -> ANALISAR -> COMBINAR -> ESCREVER ===\n");
+    printf("Threads por estágio: %d,%d,%d,%d | Fila: %d lotes de %d itens | Bloco: %d KB\n", threads[0],
+           threads[1], threads[2], threads[3], CAPACIDADE_FILA, ITENS_POR_LOTE, TAMANHO_BLOCO >> 10);
+
+    if (argc > 2) {
+        ListaArquivos lista;
+        lista_iniciar(&lista);
+        if (lista_diretorio(&lista, argv[2]) != 0) return 1;
+        medir_pipeline(&lista, argv[2], threads);
+        lista_liberar(&lista);
+        printf("\nRelatório por arquivo em %s\n", ARQUIVO_SAIDA);
+        return 0;
+    }
+
+    // Sem diretório: os mesmos conjuntos sintéticos de tarefa7_arquivos.c
+    const char *base = DIRETORIO_PADRAO;
+    struct { const char *nome; int num; size_t tamanho; } conjuntos[] = {
+        {"pequenos", 8192, 4 << 10},
+        {"medios", 32, 1 << 20},
+        {"grandes", 2, 16 << 20},
+    };
+    mkdir(base, 0755);
+    for (int i = 0; i < 3; i++) {
+        char dir[512];
+        snprintf(dir, sizeof(dir), "%s/%s", base, conjuntos[i].nome);
+        if (gerar_conjunto(dir, conjuntos[i].nome, conjuntos[i].num, conjuntos[i].tamanho) != 0) return 1;
+
+        ListaArquivos lista;
+        lista_iniciar(&lista);
+        lista_diretorio(&lista, dir);
+        char descricao[128];
+        snprintf(descricao, sizeof(descricao), "Conjunto '%s' (%zu KB por arquivo)", conjuntos[i].nome,
+                 conjuntos[i].tamanho >> 10);
+        medir_pipeline(&lista, descricao, threads);
+        lista_liberar(&lista);
+    }
+    printf("\nRelatório por arquivo (último conjunto) em %s\n", ARQUIVO_SAIDA);
+    return 0;
+}
+
+// Compilação: gcc -O2 -fopenmp tarefa7_pipeline.c -o tarefa7_pipeline -lpthread
+// Execução:   ./tarefa7_pipeline [ler,analisar,combinar,escrever] [diretorio]
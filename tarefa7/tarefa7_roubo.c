@@ -0,0 +1,261 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <omp.h>
+#include "../comum/roubo_trabalho.h"
+
+// Mesma lista da tarefa7, com um campo para o resultado do processamento
+typedef struct No {
+    char nome_arquivo[50];
+    uint64_t resultado;
+    struct No* proximo;
+} No;
+
+static int custo = 0;   // Rodadas extras de hash por nó (0 = só a sobrecarga da task)
+
+// Processamento de um nó: hash FNV-1a do nome, repetido 1 + custo vezes
+void processar_no(No* no) {
+    uint64_t h = 1469598103934665603ULL;
+    for (int r = 0; r <= custo; r++) {
+        for (const char* c = no->nome_arquivo; *c; c++) h = (h ^ (unsigned char)*c) * 1099511628211ULL;
+    }
+    no->resultado = h;
+}
+
+// Lista com N nós, inserção no fim em O(1)
+No* criar_lista(long n) {
+    No* cabeca = NULL;
+    No** fim = &cabeca;
+    for (long i = 0; i < n; i++) {
+        No* novo = malloc(sizeof(No));
+        if (novo == NULL) {
+            fprintf(stderr, "Erro ao alocar memória para a lista\n");
+            exit(1);
+        }
+        snprintf(novo->nome_arquivo, sizeof(novo->nome_arquivo), "arquivo_%07ld.txt", i);
+        novo->resultado = 0;
+        novo->proximo = NULL;
+        *fim = novo;
+        fim = &novo->proximo;
+    }
+    return cabeca;
+}
+
+void liberar_lista(No* cabeca) {
+    while (cabeca != NULL) {
+        No* prox = cabeca->proximo;
+        free(cabeca);
+        cabeca = prox;
+    }
+}
+
+uint64_t soma_resultados(No* cabeca) {
+    uint64_t s = 0;
+    for (No* no = cabeca; no != NULL; no = no->proximo) s += no->resultado;
+    return s;
+}
+
+void zerar_resultados(No* cabeca) {
+    for (No* no = cabeca; no != NULL; no = no->proximo) no->resultado = 0;
+}
+
+// ---------------------------------------------------------------------------
+// Versões
+// ---------------------------------------------------------------------------
+
+// Como na tarefa7: uma thread percorre a lista dentro do single e cria todas as tasks
+void percorrer_omp(No* cabeca, int nthreads) {
+    #pragma omp parallel num_threads(nthreads)
+    #pragma omp single
+    for (No* no = cabeca; no != NULL; no = no->proximo) {
+        #pragma omp task firstprivate(no)
+        processar_no(no);
+    }
+}
+
+void *proximo_no(void *no) {
+    return ((No*)no)->proximo;
+}
+
+void corpo_no(void *no, void *arg) {
+    (void)arg;
+    processar_no(no);
+}
+
+void raiz_lista(void *cabeca) {
+    rt_percorrer_lista(cabeca, proximo_no, corpo_no, NULL);
+}
+
+// Parallel-for sobre um vetor de ponteiros (a lista já convertida), grão de 1 nó por task
+void corpo_for(long inicio, long fim, void *arg) {
+    No** vetor = arg;
+    for (long i = inicio; i < fim; i++) processar_no(vetor[i]);
+}
+
+typedef struct {
+    No** vetor;
+    long n;
+} ArgFor;
+
+void raiz_for(void *p) {
+    ArgFor *a = p;
+    rt_paralelo_for(0, a->n, 1, corpo_for, a->vetor);
+}
+
+// Fork-join: Fibonacci recursivo, uma task por chamada
+long fib_seq(int n) {
+    return n < 2 ? n : fib_seq(n - 1) + fib_seq(n - 2);
+}
+
+long fib_omp(int n) {
+    if (n < 2) return n;
+    long x, y;
+    #pragma omp task shared(x)
+    x = fib_omp(n - 1);
+    y = fib_omp(n - 2);
+    #pragma omp taskwait
+    return x + y;
+}
+
+typedef struct {
+    int n;
+    long resultado;
+} ArgFib;
+
+void fib_rt(void *p, void *nao_usado) {
+    (void)nao_usado;
+    ArgFib *a = p;
+    if (a->n < 2) {
+        a->resultado = a->n;
+        return;
+    }
+    ArgFib x = {a->n - 1, 0}, y = {a->n - 2, 0};
+    RtGrupo g;
+    rt_grupo_iniciar(&g);
+    rt_spawn(&g, fib_rt, &x, NULL);
+    fib_rt(&y, NULL);
+    rt_esperar(&g);
+    a->resultado = x.resultado + y.resultado;
+}
+
+void raiz_fib(void *p) {
+    fib_rt(p, NULL);
+}
+
+// ---------------------------------------------------------------------------
+// Medição
+// ---------------------------------------------------------------------------
+void imprimir_linha(long n, const char* versao, double tempo, long tasks, int nthreads, double tempo_seq, int ok) {
+    // Sobrecarga: tempo de CPU somado das threads além do sequencial, dividido pelas tasks
+    printf("%-9ld %-24s %-11.4f %-10.1f %-14.1f %-6s\n", n, versao, tempo, tempo / tasks * 1e9,
+           (tempo * nthreads - tempo_seq) / tasks * 1e9, ok ? "ok" : "ERRO");
+}
+
+void medir_lista(long n, int nthreads, Runtime *rt) {
+    No* lista = criar_lista(n);
+    No** vetor = malloc(n * sizeof(No*));
+    if (vetor == NULL) {
+        fprintf(stderr, "Erro ao alocar memória para o vetor\n");
+        exit(1);
+    }
+    long i = 0;
+    for (No* no = lista; no != NULL; no = no->proximo) vetor[i++] = no;
+
+    // Listas pequenas: repete para o tempo ficar mensurável (inclui abrir/fechar a região)
+    long repeticoes = n >= 1000000 ? 3 : 1000000 / n;
+    long tasks = n * repeticoes;
+
+    double inicio = omp_get_wtime();
+    for (long r = 0; r < repeticoes; r++) {
+        for (No* no = lista; no != NULL; no = no->proximo) processar_no(no);
+    }
+    double tempo_seq = omp_get_wtime() - inicio;
+    uint64_t referencia = soma_resultados(lista);
+    imprimir_linha(n, "Sequencial", tempo_seq, tasks, 1, tempo_seq, 1);
+
+    zerar_resultados(lista);
+    inicio = omp_get_wtime();
+    for (long r = 0; r < repeticoes; r++) percorrer_omp(lista, nthreads);
+    double tempo = omp_get_wtime() - inicio;
+    imprimir_linha(n, "OpenMP single+task", tempo, tasks, nthreads, tempo_seq, soma_resultados(lista) == referencia);
+
+    zerar_resultados(lista);
+    inicio = omp_get_wtime();
+    for (long r = 0; r < repeticoes; r++) rt_executar(rt, raiz_lista, lista);
+    tempo = omp_get_wtime() - inicio;
+    imprimir_linha(n, "Roubo: lista", tempo, tasks, nthreads, tempo_seq, soma_resultados(lista) == referencia);
+
+    zerar_resultados(lista);
+    ArgFor arg = {vetor, n};
+    inicio = omp_get_wtime();
+    for (long r = 0; r < repeticoes; r++) rt_executar(rt, raiz_for, &arg);
+    tempo = omp_get_wtime() - inicio;
+    imprimir_linha(n, "Roubo: parallel-for", tempo, tasks, nthreads, tempo_seq, soma_resultados(lista) == referencia);
+
+    free(vetor);
+    liberar_lista(lista);
+}
+
+void medir_fib(int n, int nthreads, Runtime *rt) {
+    long tasks = 0;
+    for (long a = 0, b = 1, k = 0; k <= n; k++) {   // Chamadas com n >= 2 criam uma task: fib(n+1) - 1
+        long c = a + b;
+        a = b;
+        b = c;
+        if (k == n) tasks = a - 1;
+    }
+
+    double inicio = omp_get_wtime();
+    long esperado = fib_seq(n);
+    double tempo_seq = omp_get_wtime() - inicio;
+    imprimir_linha(n, "Sequencial", tempo_seq, tasks, 1, tempo_seq, 1);
+
+    long resultado = 0;
+    inicio = omp_get_wtime();
+    #pragma omp parallel num_threads(nthreads)
+    #pragma omp single
+    resultado = fib_omp(n);
+    double tempo = omp_get_wtime() - inicio;
+    imprimir_linha(n, "OpenMP task/taskwait", tempo, tasks, nthreads, tempo_seq, resultado == esperado);
+
+    ArgFib arg = {n, 0};
+    inicio = omp_get_wtime();
+    rt_executar(rt, raiz_fib, &arg);
+    tempo = omp_get_wtime() - inicio;
+    imprimir_linha(n, "Roubo: spawn/esperar", tempo, tasks, nthreads, tempo_seq, arg.resultado == esperado);
+}
+
+int main(int argc, char *argv[]) {
+    int nthreads = argc > 1 ? atoi(argv[1]) : omp_get_max_threads();
+    custo = argc > 2 ? atoi(argv[2]) : 0;
+    if (nthreads < 1) nthreads = 1;
+
+    printf("=== RUNTIME COM ROUBO DE TRABALHO vs OPENMP TASKS ===\n");
+    printf("Threads: %d | Rodadas de hash por nó: %d\n", nthreads, 1 + custo);
+
+    Runtime rt;
+    rt_iniciar(&rt, nthreads);
+
+    printf("\nLista encadeada (uma task por nó)\n");
+    printf("%-9s %-24s %-11s %-10s %-14s %-6s\n", "Nos", "Versao", "Tempo (s)", "ns/task", "Sobrecarga ns", "Result");
+    long tamanhos[] = {10, 10000, 1000000};
+    for (int i = 0; i < 3; i++) medir_lista(tamanhos[i], nthreads, &rt);
+
+    printf("\nFork-join: Fibonacci recursivo (uma task por chamada)\n");
+    printf("%-9s %-24s %-11s %-10s %-14s %-6s\n", "n", "Versao", "Tempo (s)", "ns/task", "Sobrecarga ns", "Result");
+    medir_fib(27, nthreads, &rt);
+
+    long executadas = 0, roubadas = 0;
+    for (int t = 0; t < rt.num_trabalhadores; t++) {
+        executadas += rt.trabalhadores[t].executadas;
+        roubadas += rt.trabalhadores[t].roubadas;
+    }
+    printf("\nRuntime: %ld tasks executadas, %ld roubadas (%.2f%%)\n", executadas, roubadas,
+           executadas > 0 ? 100.0 * roubadas / executadas : 0.0);
+    rt_finalizar(&rt);
+    return 0;
+}
+
+// Compilação: gcc -O2 -fopenmp tarefa7_roubo.c -o tarefa7_roubo -lpthread
+// Execução:   ./tarefa7_roubo [threads] [rodadas_extras]
@@ -2,6 +2,11 @@
 #include <stdlib.h>
 #include <omp.h>
 #include <time.h>
+#include "../comum/rng.h"
+#include "../comum/contador_fragmentado.h"
+
+#define PONTOS_POR_BLOCO 65536 // Blocos fixos: o fluxo depende do bloco, não da thread
+#define SEMENTE 2024
 
 int main(int argc, char *argv[]) {
     long long int N = 100000000; // número de pontos
@@ -31,8 +36,8 @@ int main(int argc, char *argv[]) {
     printf("Tempo: %.5f s\n\n", end - start);
 
     // Versão 2: vetor compartilhado
-    long long int *acertos_vet = malloc(nthreads * sizeof(long long int));
-    for (int i = 0; i < nthreads; i++) acertos_vet[i] = 0;
+    ContadorFragmentado acertos_vet; // Um fragmento por thread, cada um em linha de cache própria
+    contador_criar(&acertos_vet, nthreads);
     start = omp_get_wtime();
     #pragma omp parallel num_threads(nthreads)
     {
@@ -44,10 +49,9 @@ int main(int argc, char *argv[]) {
             double y = (double)rand() / RAND_MAX;
             if (x*x + y*y <= 1.0) acertos_priv++;
         }
-        acertos_vet[tid] = acertos_priv;
+        contador_somar(contador_preparar_local(&acertos_vet, tid), acertos_priv);
     }
-    long long int acertos_total = 0;
-    for (int i = 0; i < nthreads; i++) acertos_total += acertos_vet[i];
+    long long int acertos_total = contador_coletar(&acertos_vet);
     pi = 4.0 * (double)acertos_total / (double)N;
     end = omp_get_wtime();
     printf("Versão 2 (rand + vetor):\n");
@@ -77,7 +81,7 @@ int main(int argc, char *argv[]) {
     printf("Tempo: %.5f s\n\n", end - start);
 
     // Versão 4: vetor compartilhado com rand_r()
-    for (int i = 0; i < nthreads; i++) acertos_vet[i] = 0;
+    contador_zerar(&acertos_vet);
     start = omp_get_wtime();
     #pragma omp parallel num_threads(nthreads)
     {
@@ -90,16 +94,111 @@ int main(int argc, char *argv[]) {
             double y = (double)rand_r(&seed) / RAND_MAX;
             if (x*x + y*y <= 1.0) acertos_priv++;
         }
-        acertos_vet[tid] = acertos_priv;
+        contador_somar(contador_preparar_local(&acertos_vet, tid), acertos_priv);
     }
-    acertos_total = 0;
-    for (int i = 0; i < nthreads; i++) acertos_total += acertos_vet[i];
+    acertos_total = contador_coletar(&acertos_vet);
     pi = 4.0 * (double)acertos_total / (double)N;
     end = omp_get_wtime();
     printf("Versão 4 (rand_r + vetor):\n");
     printf("pi = %.10f\n", pi);
-    printf("Tempo: %.5f s\n", end - start);
+    printf("Tempo: %.5f s\n\n", end - start);
+
+    // Versão 5: xoshiro256++ com um fluxo por bloco (jump de 2^128 entre blocos)
+    long long int num_blocos = (N + PONTOS_POR_BLOCO - 1) / PONTOS_POR_BLOCO;
+    Xoshiro256 *fluxos = malloc(num_blocos * sizeof(Xoshiro256));
+    contador_zerar(&acertos_vet);
+    start = omp_get_wtime();
+    xoshiro256_fluxos(fluxos, num_blocos, SEMENTE); // Fluxos disjuntos, um por bloco
+    #pragma omp parallel num_threads(nthreads)
+    {
+        int tid = omp_get_thread_num();
+        long long int acertos_priv = 0;
+        #pragma omp for schedule(static)
+        for (long long int b = 0; b < num_blocos; b++) {
+            Xoshiro256 g = fluxos[b];
+            long long int fim = (b + 1) * PONTOS_POR_BLOCO < N ? (b + 1) * PONTOS_POR_BLOCO : N;
+            for (long long int i = b * PONTOS_POR_BLOCO; i < fim; i++) {
+                double x = rng_u64_para_double(xoshiro256pp_proximo(&g));
+                double y = rng_u64_para_double(xoshiro256pp_proximo(&g));
+                if (x*x + y*y <= 1.0) acertos_priv++;
+            }
+        }
+        contador_somar(contador_preparar_local(&acertos_vet, tid), acertos_priv);
+    }
+    acertos_total = contador_coletar(&acertos_vet);
+    pi = 4.0 * (double)acertos_total / (double)N;
+    end = omp_get_wtime();
+    free(fluxos);
+    printf("Versão 5 (xoshiro256++ com jump por bloco + vetor):\n");
+    printf("pi = %.10f\n", pi);
+    printf("Tempo: %.5f s\n\n", end - start);
+
+    // Versão 6: Philox4x32-10, o par de pontos j usa o contador j (sem estado)
+    contador_zerar(&acertos_vet);
+    start = omp_get_wtime();
+    #pragma omp parallel num_threads(nthreads)
+    {
+        int tid = omp_get_thread_num();
+        long long int acertos_priv = 0;
+        #pragma omp for
+        for (long long int j = 0; j < (N + 1) / 2; j++) { // 4 valores de 32 bits = 2 pontos
+            Philox4x32 r = philox_gerar(SEMENTE, (uint64_t)j);
+            double x = rng_u32_para_double(r.v[0]);
+            double y = rng_u32_para_double(r.v[1]);
+            if (x*x + y*y <= 1.0) acertos_priv++;
+            if (2 * j + 1 < N) {
+                x = rng_u32_para_double(r.v[2]);
+                y = rng_u32_para_double(r.v[3]);
+                if (x*x + y*y <= 1.0) acertos_priv++;
+            }
+        }
+        contador_somar(contador_preparar_local(&acertos_vet, tid), acertos_priv);
+    }
+    acertos_total = contador_coletar(&acertos_vet);
+    pi = 4.0 * (double)acertos_total / (double)N;
+    end = omp_get_wtime();
+    printf("Versão 6 (Philox4x32-10 por contador + vetor):\n");
+    printf("pi = %.10f\n", pi);
+    printf("Tempo: %.5f s\n\n", end - start);
+
+    // Taxa de geração por thread (números de 32+ bits por segundo)
+    printf("Taxa de geração (%d threads, %lld números por gerador):\n", nthreads, 2 * N);
+    unsigned long long soma_rand_r = 0, soma_xoshiro = 0, soma_philox = 0; // Evita que o laço seja eliminado
+    start = omp_get_wtime();
+    #pragma omp parallel num_threads(nthreads) reduction(+:soma_rand_r)
+    {
+        unsigned int seed = SEMENTE + omp_get_thread_num();
+        #pragma omp for
+        for (long long int i = 0; i < 2 * N; i++) soma_rand_r += rand_r(&seed);
+    }
+    double tempo_rand_r = omp_get_wtime() - start;
+
+    start = omp_get_wtime();
+    #pragma omp parallel num_threads(nthreads) reduction(+:soma_xoshiro)
+    {
+        Xoshiro256 g;
+        xoshiro256_semear(&g, SEMENTE);
+        for (int j = 0; j <= omp_get_thread_num(); j++) xoshiro256_jump(&g);
+        #pragma omp for
+        for (long long int i = 0; i < 2 * N; i++) soma_xoshiro += xoshiro256pp_proximo(&g);
+    }
+    double tempo_xoshiro = omp_get_wtime() - start;
+
+    start = omp_get_wtime();
+    #pragma omp parallel for num_threads(nthreads) reduction(+:soma_philox)
+    for (long long int i = 0; i < N / 2; i++) { // 4 números por chamada
+        Philox4x32 r = philox_gerar(SEMENTE, (uint64_t)i);
+        soma_philox += (unsigned long long)r.v[0] + r.v[1] + r.v[2] + r.v[3];
+    }
+    double tempo_philox = omp_get_wtime() - start;
+
+    printf("  rand_r:      %8.1f M números/s por thread (checksum %llu)\n",
+           2 * N / tempo_rand_r / nthreads / 1e6, soma_rand_r % 1000);
+    printf("  xoshiro256++:%8.1f M números/s por thread (checksum %llu)\n",
+           2 * N / tempo_xoshiro / nthreads / 1e6, soma_xoshiro % 1000);
+    printf("  Philox4x32:  %8.1f M números/s por thread (checksum %llu)\n",
+           2 * N / tempo_philox / nthreads / 1e6, soma_philox % 1000);
 
-    free(acertos_vet);
+    contador_destruir(&acertos_vet);
     return 0;
 }
@@ -0,0 +1,268 @@
+#ifndef HASH_CONCORRENTE_H
+#define HASH_CONCORRENTE_H
+
+// Tabela hash concorrente (chave int -> valor int) que generaliza as N listas com trava
+//
+// - Travas por faixa (striping): MAP_FAIXAS omp_lock_t fixos; o balde b usa a trava b % MAP_FAIXAS.
+//   Como os tamanhos da tabela são potências de 2 maiores ou iguais a MAP_FAIXAS, um balde e os
+//   dois baldes em que ele se divide na tabela nova caem na mesma faixa
+// - Leituras sem trava: map_lookup só lê ponteiros atômicos dentro de uma seção de época
+//   (treiber_ebr.h). Escritores publicam nós com store-release e nunca alteram o 'next' de um
+//   nó já visível, a não ser para desligar o seguinte; nós removidos e tabelas antigas só são
+//   liberados quando nenhum leitor pode mais vê-los
+// - Crescimento incremental, sem parar todas as threads: quando uma faixa passa da carga
+//   média, uma tabela com o dobro de baldes é montada e instalada, com todas as travas de faixa
+//   na mão, como 'cur', e a antiga vira 'old': quem tem uma trava de faixa sempre vê o par
+//   (cur, old) de um mesmo crescimento. Cada escrita migra primeiro o balde antigo da própria
+//   chave e depois mais MAP_MIGRAR_POR_OP baldes. A migração copia os nós para a tabela nova e
+//   marca o balde antigo com MAP_MIGRADO; o leitor que encontra a marca relê as tabelas e
+//   procura de novo
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdatomic.h>
+#include <omp.h>
+#include "treiber_ebr.h"
+
+#define MAP_FAIXAS 64                 // Travas (potência de 2)
+#define MAP_CARGA 2                   // Elementos por balde que disparam o crescimento
+#define MAP_MIGRAR_POR_OP 2
+
+typedef struct HNode {
+    int key;
+    atomic_int value;
+    _Atomic(struct HNode *) next;
+} HNode;
+
+#define MAP_MIGRADO ((HNode *)1)
+
+typedef struct {
+    size_t size;                                  // Potência de 2
+    atomic_size_t migrate_next;                   // Enquanto antiga: próximo balde a migrar
+    atomic_size_t migrated;                       // Enquanto antiga: baldes já migrados
+    _Atomic(HNode *) buckets[];
+} HTable;
+
+typedef struct {
+    _Alignas(128) omp_lock_t lock;
+    long count;                                   // Elementos nos baldes desta faixa
+} HStripe;
+
+typedef struct {
+    _Alignas(128) _Atomic(HTable *) cur;
+    _Atomic(HTable *) old;                        // Tabela em migração (NULL fora do crescimento)
+    atomic_int resizes;
+    omp_lock_t resize_lock;
+    HStripe stripes[MAP_FAIXAS];
+    Ebr ebr;
+} ConcurrentMap;
+
+static inline uint64_t map_hash(int key) {
+    uint64_t h = (uint32_t)key * 0x9E3779B97F4A7C15ULL;
+    return h ^ (h >> 29);
+}
+
+static inline HTable *map_new_table(size_t size) {
+    HTable *t = malloc(sizeof(HTable) + size * sizeof(_Atomic(HNode *)));
+    if (t == NULL) {
+        fprintf(stderr, "Erro ao alocar memória para a tabela hash\n");
+        exit(1);
+    }
+    t->size = size;
+    atomic_init(&t->migrate_next, 0);
+    atomic_init(&t->migrated, 0);
+    for (size_t i = 0; i < size; i++) atomic_init(&t->buckets[i], NULL);
+    return t;
+}
+
+static inline HNode *map_new_node(int key, int value, HNode *next) {
+    HNode *n = malloc(sizeof(HNode));
+    if (n == NULL) {
+        fprintf(stderr, "Erro ao alocar memória para nó da tabela\n");
+        exit(1);
+    }
+    n->key = key;
+    atomic_init(&n->value, value);
+    atomic_init(&n->next, next);
+    return n;
+}
+
+static inline void map_init(ConcurrentMap *m, size_t initial) {
+    size_t size = MAP_FAIXAS;
+    while (size < initial) size *= 2;
+    atomic_init(&m->cur, map_new_table(size));
+    atomic_init(&m->old, NULL);
+    atomic_init(&m->resizes, 0);
+    omp_init_lock(&m->resize_lock);
+    for (int i = 0; i < MAP_FAIXAS; i++) {
+        omp_init_lock(&m->stripes[i].lock);
+        m->stripes[i].count = 0;
+    }
+    ebr_init(&m->ebr, free);
+}
+
+static inline HNode *map_find(HNode *c, int key) {
+    while (c != NULL && c->key != key) c = atomic_load_explicit(&c->next, memory_order_acquire);
+    return c;
+}
+
+// Copia o balde antigo ob para a tabela nova e o marca como migrado (chamar com a trava da faixa)
+static inline void map_migrate_bucket(ConcurrentMap *m, EbrThread *et, HTable *o, size_t ob, HTable *t) {
+    HNode *c = atomic_load_explicit(&o->buckets[ob], memory_order_relaxed);
+    if (c == MAP_MIGRADO) return;
+    while (c != NULL) {
+        uint64_t h = map_hash(c->key);
+        _Atomic(HNode *) *dst = &t->buckets[h & (t->size - 1)];
+        HNode *n = map_new_node(c->key, atomic_load_explicit(&c->value, memory_order_relaxed),
+                                atomic_load_explicit(dst, memory_order_relaxed));
+        atomic_store_explicit(dst, n, memory_order_release);
+        HNode *next = atomic_load_explicit(&c->next, memory_order_relaxed);
+        ebr_retire(&m->ebr, et, c);
+        c = next;
+    }
+    atomic_store_explicit(&o->buckets[ob], MAP_MIGRADO, memory_order_release);
+    if (atomic_fetch_add(&o->migrated, 1) + 1 == o->size) {      // Último balde: fim da migração
+        atomic_store_explicit(&m->old, NULL, memory_order_release);
+        ebr_retire(&m->ebr, et, o);
+    }
+}
+
+// Trava a faixa da chave e devolve o balde da tabela atual, migrando antes o balde antigo
+static inline _Atomic(HNode *) *map_lock_bucket(ConcurrentMap *m, EbrThread *et, uint64_t h, HStripe **s) {
+    *s = &m->stripes[h & (MAP_FAIXAS - 1)];
+    omp_set_lock(&(*s)->lock);
+    HTable *t = atomic_load_explicit(&m->cur, memory_order_acquire);     // cur antes de old
+    HTable *o = atomic_load_explicit(&m->old, memory_order_acquire);
+    if (o != NULL) map_migrate_bucket(m, et, o, h & (o->size - 1), t);
+    return &t->buckets[h & (t->size - 1)];
+}
+
+// Migra alguns baldes da tabela antiga (sem nenhuma trava de faixa na mão)
+static inline void map_help_migrate(ConcurrentMap *m, EbrThread *et) {
+    for (int k = 0; k < MAP_MIGRAR_POR_OP; k++) {
+        HTable *o = atomic_load_explicit(&m->old, memory_order_acquire);
+        if (o == NULL) return;
+        size_t ob = atomic_fetch_add(&o->migrate_next, 1);
+        if (ob >= o->size) return;
+        HStripe *s = &m->stripes[ob & (MAP_FAIXAS - 1)];
+        omp_set_lock(&s->lock);
+        if (atomic_load_explicit(&m->old, memory_order_acquire) == o)     // Com a trava: cur é a sucessora de o
+            map_migrate_bucket(m, et, o, ob, atomic_load_explicit(&m->cur, memory_order_acquire));
+        omp_unset_lock(&s->lock);
+    }
+}
+
+// Instala a tabela com o dobro de baldes se nenhuma migração estiver em curso. A tabela nova é
+// montada antes de publicar qualquer coisa, e a troca é feita com todas as faixas travadas: um
+// escritor nunca vê old já trocado e cur ainda antigo (migraria um balde para ele mesmo)
+static inline void map_grow(ConcurrentMap *m, HTable *seen) {
+    if (!omp_test_lock(&m->resize_lock)) return;               // Outra thread já está crescendo
+    HTable *t = atomic_load(&m->cur);
+    if (t == seen && atomic_load(&m->old) == NULL) {
+        HTable *n = map_new_table(2 * t->size);
+        for (int i = 0; i < MAP_FAIXAS; i++) omp_set_lock(&m->stripes[i].lock);
+        atomic_store_explicit(&m->old, t, memory_order_release);    // old antes de cur (leitores sem trava)
+        atomic_store_explicit(&m->cur, n, memory_order_release);
+        for (int i = 0; i < MAP_FAIXAS; i++) omp_unset_lock(&m->stripes[i].lock);
+        atomic_fetch_add(&m->resizes, 1);
+    }
+    omp_unset_lock(&m->resize_lock);
+}
+
+// Busca sem trava; devolve 1 e o valor se a chave existe
+static inline int map_lookup(ConcurrentMap *m, int key, int *value) {
+    uint64_t h = map_hash(key);
+    EbrThread *et = ebr_enter(&m->ebr);
+    HNode *c;
+    for (;;) {
+        HTable *t = atomic_load_explicit(&m->cur, memory_order_acquire);
+        HTable *o = atomic_load_explicit(&m->old, memory_order_acquire);
+        c = MAP_MIGRADO;
+        if (o != NULL) c = atomic_load_explicit(&o->buckets[h & (o->size - 1)], memory_order_acquire);
+        if (c == MAP_MIGRADO) c = atomic_load_explicit(&t->buckets[h & (t->size - 1)], memory_order_acquire);
+        if (c != MAP_MIGRADO) break;              // Balde da tabela atual virou antigo: relê as tabelas
+    }
+    c = map_find(c, key);
+    int found = c != NULL;
+    if (found) *value = atomic_load_explicit(&c->value, memory_order_relaxed);
+    ebr_exit(et);
+    return found;
+}
+
+// Insere ou atualiza; devolve 1 se a chave é nova
+static inline int map_insert(ConcurrentMap *m, int key, int value) {
+    uint64_t h = map_hash(key);
+    EbrThread *et = ebr_enter(&m->ebr);
+    HStripe *s;
+    _Atomic(HNode *) *b = map_lock_bucket(m, et, h, &s);
+    HNode *head = atomic_load_explicit(b, memory_order_relaxed);
+    HNode *c = map_find(head, key);
+    int inserted = c == NULL;
+    if (c != NULL) {
+        atomic_store_explicit(&c->value, value, memory_order_relaxed);
+    } else {
+        atomic_store_explicit(b, map_new_node(key, value, head), memory_order_release);
+        s->count++;
+    }
+    HTable *t = atomic_load_explicit(&m->cur, memory_order_relaxed);
+    int full = (size_t)s->count * MAP_FAIXAS > t->size * MAP_CARGA;   // Carga estimada pela faixa
+    omp_unset_lock(&s->lock);
+    if (full) map_grow(m, t);
+    map_help_migrate(m, et);
+    ebr_exit(et);
+    return inserted;
+}
+
+// Remove; devolve 1 se a chave existia
+static inline int map_erase(ConcurrentMap *m, int key) {
+    uint64_t h = map_hash(key);
+    EbrThread *et = ebr_enter(&m->ebr);
+    HStripe *s;
+    _Atomic(HNode *) *link = map_lock_bucket(m, et, h, &s);
+    HNode *c = atomic_load_explicit(link, memory_order_relaxed);
+    while (c != NULL && c->key != key) {
+        link = &c->next;
+        c = atomic_load_explicit(link, memory_order_relaxed);
+    }
+    if (c != NULL) {
+        // Quem está lendo c continua vendo c->next: o nó só é liberado depois das épocas
+        atomic_store_explicit(link, atomic_load_explicit(&c->next, memory_order_relaxed), memory_order_release);
+        ebr_retire(&m->ebr, et, c);
+        s->count--;
+    }
+    omp_unset_lock(&s->lock);
+    map_help_migrate(m, et);
+    ebr_exit(et);
+    return c != NULL;
+}
+
+// Elementos e baldes atuais (sem escritores ativos)
+static inline long map_size(ConcurrentMap *m) {
+    long n = 0;
+    for (int i = 0; i < MAP_FAIXAS; i++) n += m->stripes[i].count;
+    return n;
+}
+
+static inline void map_destroy(ConcurrentMap *m) {
+    HTable *tables[2] = { atomic_load(&m->old), atomic_load(&m->cur) };
+    for (int k = 0; k < 2; k++) {
+        HTable *t = tables[k];
+        if (t == NULL) continue;
+        for (size_t i = 0; i < t->size; i++) {
+            HNode *c = atomic_load(&t->buckets[i]);
+            if (c == MAP_MIGRADO) continue;
+            while (c != NULL) {
+                HNode *next = atomic_load(&c->next);
+                free(c);
+                c = next;
+            }
+        }
+        free(t);
+    }
+    ebr_destroy(&m->ebr, NULL, NULL);
+    omp_destroy_lock(&m->resize_lock);
+    for (int i = 0; i < MAP_FAIXAS; i++) omp_destroy_lock(&m->stripes[i].lock);
+}
+
+#endif // HASH_CONCORRENTE_H
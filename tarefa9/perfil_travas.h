@@ -0,0 +1,231 @@
+#ifndef PERFIL_TRAVAS_H
+#define PERFIL_TRAVAS_H
+
+// Perfil de disputa de travas: travas de travas.h (omp_lock_t por padrão) com contadores, e um
+// substituto para critical nomeada
+//
+// - Por trava: aquisições, aquisições disputadas, espera total e máxima, e tempo de posse
+// - Sem disputa, a aquisição é um lock_try e um incremento; a espera só é cronometrada
+//   quando o test_lock falha. A posse é cronometrada em 1 de cada PERFIL_AMOSTRA aquisições (e em
+//   todas as disputadas), e o total é estimado pela média das amostras: ler o contador de ciclos
+//   em toda aquisição custaria mais que a própria trava. Os contadores são atualizados por quem
+//   está com a trava, então não precisam de atômicas
+// - No fim do programa (atexit) imprime uma tabela por trava. Com PERFIL_TRAVAS_JSON=arquivo no
+//   ambiente, grava também o mesmo relatório em JSON
+// - PROFILED_CRITICAL(nome) { ... } substitui #pragma omp critical(nome); cada nome precisa de um
+//   PROFILED_CRITICAL_DEFINE(nome) no escopo do arquivo. O corpo não pode sair com break, return
+//   ou goto (a trava não seria liberada)
+// - Compilar com -DPERFIL_TRAVAS_DESATIVADO volta às chamadas diretas da trava e ao pragma original
+// - Com o registro cheio (PERFIL_MAX_TRAVAS), as travas seguintes funcionam sem perfil e o
+//   relatório informa quantas ficaram de fora
+//
+// Uso:
+//   ProfiledLock l;  plock_init(&l, "lista 1");  plock_set(&l); ... plock_unset(&l);  plock_destroy(&l);
+//   plock_init_type(&l, "lista 1", LOCK_MCS);      // Outra implementação de travas.h
+//   PROFILED_CRITICAL_DEFINE(lista1)
+//   PROFILED_CRITICAL(lista1) { ... }
+
+#include <omp.h>
+#include "travas.h"
+
+#define PERFIL_STR_(x) #x
+#define PERFIL_STR(x) PERFIL_STR_(x)
+
+#ifndef PERFIL_TRAVAS_DESATIVADO
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdatomic.h>
+#include <time.h>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+#define PERFIL_MAX_TRAVAS 1024
+#define PERFIL_NOME 32
+#ifndef PERFIL_AMOSTRA
+#define PERFIL_AMOSTRA 16             // Potência de 2; 1 cronometra a posse em toda aquisição
+#endif
+
+typedef struct {
+    _Alignas(128) char name[PERFIL_NOME];
+    uint64_t acquisitions;
+    uint64_t contended;
+    uint64_t wait_total;                  // Em ciclos do contador (convertidos no relatório)
+    uint64_t wait_max;
+    uint64_t hold_sampled;                // Soma das posses cronometradas
+    uint64_t hold_samples;
+} PerfilRegistro;
+
+typedef struct {
+    Lock lock;
+    uint64_t hold_start;                  // Escrito por quem está com a trava; 0 = posse não amostrada
+    PerfilRegistro *reg;                  // NULL: registro cheio, trava sem perfil
+} ProfiledLock;
+
+static PerfilRegistro perfil_registros[PERFIL_MAX_TRAVAS];
+static atomic_int perfil_num = 0;
+static atomic_int perfil_iniciado = 0;
+static uint64_t perfil_tsc_inicio;
+static struct timespec perfil_ts_inicio;
+
+static inline uint64_t perfil_ciclos(void) {
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+#endif
+}
+
+// Nanossegundos por ciclo, medidos entre a primeira trava e o relatório
+static inline double perfil_ns_por_ciclo(void) {
+#if defined(__x86_64__) || defined(__i386__)
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    double ns = (ts.tv_sec - perfil_ts_inicio.tv_sec) * 1e9 + (ts.tv_nsec - perfil_ts_inicio.tv_nsec);
+    uint64_t ciclos = perfil_ciclos() - perfil_tsc_inicio;
+    return ciclos > 0 ? ns / ciclos : 1.0;
+#else
+    return 1.0;
+#endif
+}
+
+static inline void perfil_relatorio(void) {
+    int n = atomic_load(&perfil_num), sem_perfil = 0;
+    if (n == 0) return;
+    if (n > PERFIL_MAX_TRAVAS) {
+        sem_perfil = n - PERFIL_MAX_TRAVAS;
+        n = PERFIL_MAX_TRAVAS;
+    }
+    double k = perfil_ns_por_ciclo() / 1e3;               // Ciclos -> µs
+    fflush(stdout);
+    fprintf(stderr, "\nPerfil de travas (tempos em us)\n");
+    fprintf(stderr, "%-16s %11s %11s %13s %11s %13s %11s\n", "Trava", "Aquisicoes", "Disputadas",
+            "Espera_total", "Espera_max", "Posse_total", "Posse_media");
+    for (int i = 0; i < n; i++) {
+        PerfilRegistro *r = &perfil_registros[i];
+        double media = r->hold_samples ? (double)r->hold_sampled / r->hold_samples * k : 0.0;
+        fprintf(stderr, "%-16s %11llu %11llu %13.1f %11.2f %13.1f %11.3f\n", r->name,
+                (unsigned long long)r->acquisitions, (unsigned long long)r->contended, r->wait_total * k,
+                r->wait_max * k, media * r->acquisitions, media);
+    }
+    if (sem_perfil > 0) {
+        fprintf(stderr, "(%d travas além das %d primeiras ficaram sem perfil)\n", sem_perfil, PERFIL_MAX_TRAVAS);
+    }
+
+    const char *arquivo = getenv("PERFIL_TRAVAS_JSON");
+    if (arquivo == NULL || arquivo[0] == '\0') return;
+    FILE *f = fopen(arquivo, "w");
+    if (f == NULL) {
+        perror("Erro ao abrir o arquivo JSON do perfil de travas");
+        return;
+    }
+    fprintf(f, "{\n  \"unidade\": \"us\",\n  \"sem_perfil\": %d,\n  \"travas\": [\n", sem_perfil);
+    for (int i = 0; i < n; i++) {
+        PerfilRegistro *r = &perfil_registros[i];
+        double media = r->hold_samples ? (double)r->hold_sampled / r->hold_samples * k : 0.0;
+        fprintf(f, "    {\"nome\": \"%s\", \"aquisicoes\": %llu, \"disputadas\": %llu, \"espera_total\": %.3f, "
+                   "\"espera_max\": %.3f, \"posse_total\": %.3f, \"posse_media\": %.4f, \"amostras_posse\": %llu}%s\n",
+                r->name, (unsigned long long)r->acquisitions, (unsigned long long)r->contended, r->wait_total * k,
+                r->wait_max * k, media * r->acquisitions, media, (unsigned long long)r->hold_samples,
+                i + 1 < n ? "," : "");
+    }
+    fprintf(f, "  ]\n}\n");
+    fclose(f);
+}
+
+static inline void plock_init_type(ProfiledLock *l, const char *name, LockType type) {
+    if (atomic_exchange(&perfil_iniciado, 1) == 0) {
+        perfil_tsc_inicio = perfil_ciclos();
+        clock_gettime(CLOCK_MONOTONIC, &perfil_ts_inicio);
+        atexit(perfil_relatorio);
+    }
+    int i = atomic_fetch_add(&perfil_num, 1);
+    l->hold_start = 0;
+    l->reg = NULL;
+    if (i < PERFIL_MAX_TRAVAS) {
+        l->reg = &perfil_registros[i];
+        snprintf(l->reg->name, PERFIL_NOME, "%s", name);
+    }
+    lock_init(&l->lock, type);
+}
+
+static inline void plock_init(ProfiledLock *l, const char *name) {
+    plock_init_type(l, name, LOCK_OMP);
+}
+
+static inline void plock_set(ProfiledLock *l) {
+    if (__builtin_expect(l->reg == NULL, 0)) {          // Sem perfil: plock_unset só libera
+        lock_acquire(&l->lock);
+        return;
+    }
+    if (__builtin_expect(lock_try(&l->lock), 1)) {
+        PerfilRegistro *r = l->reg;
+        l->hold_start = (r->acquisitions++ & (PERFIL_AMOSTRA - 1)) == 0 ? perfil_ciclos() : 0;
+        return;
+    }
+    uint64_t inicio = perfil_ciclos();
+    lock_acquire(&l->lock);
+    uint64_t agora = perfil_ciclos(), espera = agora - inicio;
+    PerfilRegistro *r = l->reg;
+    l->hold_start = agora;
+    r->acquisitions++;
+    r->contended++;
+    r->wait_total += espera;
+    if (espera > r->wait_max) r->wait_max = espera;
+}
+
+static inline void plock_unset(ProfiledLock *l) {
+    if (l->hold_start != 0) {
+        PerfilRegistro *r = l->reg;
+        r->hold_sampled += perfil_ciclos() - l->hold_start;
+        r->hold_samples++;
+    }
+    lock_release(&l->lock);
+}
+
+// Os números da trava continuam no relatório depois de destruída
+static inline void plock_destroy(ProfiledLock *l) {
+    lock_destroy(&l->lock);
+}
+
+static inline int perfil_critica_entrar(ProfiledLock *l) {
+    plock_set(l);
+    return 1;
+}
+
+static inline int perfil_critica_sair(ProfiledLock *l) {
+    plock_unset(l);
+    return 0;
+}
+
+#define PROFILED_CRITICAL_DEFINE(nome)                                                  \
+    static ProfiledLock perfil_critica_##nome;                                          \
+    __attribute__((constructor)) static void perfil_critica_iniciar_##nome(void) {      \
+        plock_init(&perfil_critica_##nome, "critical(" PERFIL_STR(nome) ")");           \
+    }
+
+#define PROFILED_CRITICAL(nome)                                                         \
+    for (int perfil_dentro_ = perfil_critica_entrar(&perfil_critica_##nome); perfil_dentro_; \
+         perfil_dentro_ = perfil_critica_sair(&perfil_critica_##nome))
+
+#else // PERFIL_TRAVAS_DESATIVADO
+
+typedef struct {
+    Lock lock;
+} ProfiledLock;
+
+#define plock_init_type(l, name, type) ((void)(name), lock_init(&(l)->lock, (type)))
+#define plock_init(l, name) plock_init_type((l), (name), LOCK_OMP)
+#define plock_set(l) lock_acquire(&(l)->lock)
+#define plock_unset(l) lock_release(&(l)->lock)
+#define plock_destroy(l) lock_destroy(&(l)->lock)
+#define PROFILED_CRITICAL_DEFINE(nome)
+#define PROFILED_CRITICAL(nome) _Pragma(PERFIL_STR(omp critical(nome)))
+
+#endif // PERFIL_TRAVAS_DESATIVADO
+
+#endif // PERFIL_TRAVAS_H
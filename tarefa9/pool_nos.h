@@ -0,0 +1,161 @@
+#ifndef POOL_NOS_H
+#define POOL_NOS_H
+
+// Alocador de objetos de tamanho fixo (nós de lista) com um cache por thread
+//
+// - A memória vem em blocos grandes (POOL_BLOCO bytes, alinhados ao próprio tamanho). O
+//   cabeçalho do bloco guarda a thread dona, achada a partir do endereço do objeto com uma máscara
+// - pool_alloc: tira da lista livre local; se vazia, avança no bloco atual; se o bloco acabou,
+//   recolhe de uma vez a fila de liberações remotas; só então pede um bloco novo. Nenhum passo
+//   usa trava, e o caminho comum não usa nem atômica
+// - pool_free de um objeto da própria thread volta para a lista livre local. De outra thread,
+//   vai para a fila remota da dona (pilha com CAS; a dona esvazia com uma troca, sem ABA)
+// - pool_destroy libera os blocos: o custo é O(blocos), sem percorrer os nós. Quem usa o pool
+//   para listas descarta a lista inteira assim, sem free nó a nó
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdatomic.h>
+
+#define POOL_BLOCO (64 * 1024)
+#define POOL_MAX_THREADS 256
+
+typedef struct PoolLivre {
+    struct PoolLivre *next;
+} PoolLivre;
+
+typedef struct PoolThread PoolThread;
+
+typedef struct PoolBloco {
+    PoolThread *owner;
+    struct PoolBloco *next;           // Lista de todos os blocos do pool
+} PoolBloco;
+
+struct PoolThread {
+    PoolLivre *free_list;             // Só a dona mexe
+    char *bump;                       // Próximo objeto nunca usado do bloco atual
+    char *end;
+    unsigned long chunks;
+    _Alignas(128) _Atomic(PoolLivre *) remote;   // Liberações vindas de outras threads
+};
+
+typedef struct {
+    size_t obj_size;
+    _Atomic(PoolBloco *) chunks;
+    _Atomic(PoolThread *) threads[POOL_MAX_THREADS];
+} NodePool;
+
+static atomic_int pool_next_id = 0;
+static __thread int pool_id = -1;
+
+static inline void pool_init(NodePool *p, size_t obj_size) {
+    if (obj_size < sizeof(PoolLivre)) obj_size = sizeof(PoolLivre);
+    p->obj_size = (obj_size + 7) & ~(size_t)7;
+    atomic_init(&p->chunks, NULL);
+    for (int i = 0; i < POOL_MAX_THREADS; i++) atomic_init(&p->threads[i], NULL);
+}
+
+// Cache da thread atual neste pool (criado na primeira chamada)
+static inline PoolThread *pool_thread(NodePool *p) {
+    if (pool_id < 0) {
+        pool_id = atomic_fetch_add(&pool_next_id, 1);
+        if (pool_id >= POOL_MAX_THREADS) {
+            fprintf(stderr, "Pool: mais de %d threads\n", POOL_MAX_THREADS);
+            exit(1);
+        }
+    }
+    PoolThread *t = atomic_load_explicit(&p->threads[pool_id], memory_order_relaxed);
+    if (t != NULL) return t;
+    if (posix_memalign((void **)&t, 128, sizeof(PoolThread)) != 0) {
+        fprintf(stderr, "Erro ao alocar memória para o cache do pool\n");
+        exit(1);
+    }
+    t->free_list = NULL;
+    t->bump = t->end = NULL;
+    t->chunks = 0;
+    atomic_init(&t->remote, NULL);
+    atomic_store_explicit(&p->threads[pool_id], t, memory_order_release);
+    return t;
+}
+
+static inline void pool_new_chunk(NodePool *p, PoolThread *t) {
+    PoolBloco *c;
+    if (posix_memalign((void **)&c, POOL_BLOCO, POOL_BLOCO) != 0) {
+        fprintf(stderr, "Erro ao alocar memória para bloco do pool\n");
+        exit(1);
+    }
+    c->owner = t;
+    c->next = atomic_load_explicit(&p->chunks, memory_order_relaxed);
+    while (!atomic_compare_exchange_weak_explicit(&p->chunks, &c->next, c, memory_order_release,
+                                                  memory_order_relaxed)) {}
+    size_t header = (sizeof(PoolBloco) + p->obj_size - 1) / p->obj_size * p->obj_size;
+    t->bump = (char *)c + header;
+    t->end = (char *)c + POOL_BLOCO - p->obj_size + 1;
+    t->chunks++;
+}
+
+static inline void *pool_alloc(NodePool *p) {
+    PoolThread *t = pool_thread(p);
+    PoolLivre *o = t->free_list;
+    if (o != NULL) {
+        t->free_list = o->next;
+        return o;
+    }
+    if (t->bump < t->end) {
+        void *r = t->bump;
+        t->bump += p->obj_size;
+        return r;
+    }
+    if (atomic_load_explicit(&t->remote, memory_order_relaxed) != NULL) {
+        o = atomic_exchange_explicit(&t->remote, NULL, memory_order_acquire);
+        t->free_list = o->next;
+        return o;
+    }
+    pool_new_chunk(p, t);
+    void *r = t->bump;
+    t->bump += p->obj_size;
+    return r;
+}
+
+static inline void pool_free(NodePool *p, void *obj) {
+    PoolBloco *c = (PoolBloco *)((uintptr_t)obj & ~(uintptr_t)(POOL_BLOCO - 1));
+    PoolThread *owner = c->owner;
+    PoolLivre *o = obj;
+    if (pool_id >= 0 && owner == atomic_load_explicit(&p->threads[pool_id], memory_order_relaxed)) {
+        o->next = owner->free_list;
+        owner->free_list = o;
+        return;
+    }
+    o->next = atomic_load_explicit(&owner->remote, memory_order_relaxed);
+    while (!atomic_compare_exchange_weak_explicit(&owner->remote, &o->next, o, memory_order_release,
+                                                  memory_order_relaxed)) {}
+}
+
+// Blocos alocados até agora (todas as threads)
+static inline unsigned long pool_chunks(NodePool *p) {
+    unsigned long n = 0;
+    for (int i = 0; i < POOL_MAX_THREADS; i++) {
+        PoolThread *t = atomic_load(&p->threads[i]);
+        if (t != NULL) n += t->chunks;
+    }
+    return n;
+}
+
+// Sem threads usando o pool: libera todos os blocos (e com eles todos os objetos)
+static inline void pool_destroy(NodePool *p) {
+    PoolBloco *c = atomic_load(&p->chunks);
+    while (c != NULL) {
+        PoolBloco *next = c->next;
+        free(c);
+        c = next;
+    }
+    atomic_store(&p->chunks, NULL);
+    for (int i = 0; i < POOL_MAX_THREADS; i++) {
+        free(atomic_load(&p->threads[i]));
+        atomic_store(&p->threads[i], NULL);
+    }
+}
+
+#endif // POOL_NOS_H
@@ -2,7 +2,8 @@
 #include <stdlib.h>
 #include <omp.h>
 #include <time.h>
-#include <unistd.h>
+#include "pool_nos.h"
+#include "perfil_travas.h"
 
 // ============================================================================
 // ESTRUTURAS DE DADOS
@@ -26,20 +27,24 @@ typedef struct {
     Node* head;
     int count;
     int id;
-    omp_lock_t lock; // Cada lista tem seu próprio lock independente
+    ProfiledLock lock; // Cada lista tem seu próprio lock independente (omp_lock_t com perfil de disputa)
 } LockedList;
 
 // ============================================================================
 // FUNÇÕES AUXILIARES
 // ============================================================================
 
+// Pool de nós: cada thread aloca do seu próprio cache, sem passar pelas travas do malloc.
+// As listas de um programa são descartadas juntas com pool_destroy, sem free nó a nó.
+NodePool node_pool;
+
+// Implementação de trava das listas (travas.h), escolhida na linha de comando: omp, ttas,
+// ticket, mcs ou futex
+LockType list_lock_type = LOCK_OMP;
+
 // Função para criar um novo nó
 Node* create_node(int data) {
-    Node* new_node = (Node*)malloc(sizeof(Node));
-    if (new_node == NULL) {
-        fprintf(stderr, "Erro ao alocar memória para novo nó\n");
-        exit(1);
-    }
+    Node* new_node = (Node*)pool_alloc(&node_pool); // Aborta se faltar memória
     new_node->data = data;
     new_node->next = NULL;
     return new_node;
@@ -57,28 +62,22 @@ void init_locked_list(LockedList* list, int id) {
     list->head = NULL;
     list->count = 0;
     list->id = id;
-    omp_init_lock(&list->lock); // Inicializa o lock antes do uso
+    char name[32];
+    snprintf(name, sizeof(name), "lista %d", id);
+    plock_init_type(&list->lock, name, list_lock_type); // Inicializa o lock antes do uso
 }
 
-// Destruir lista simples
+// Destruir lista simples (os nós voltam todos de uma vez com pool_destroy)
 void destroy_simple_list(SimpleList* list) {
-    Node* current = list->head;
-    while (current != NULL) {
-        Node* temp = current;
-        current = current->next;
-        free(temp);
-    }
+    list->head = NULL;
+    list->count = 0;
 }
 
-// Destruir lista com lock
+// Destruir lista com lock (os nós voltam todos de uma vez com pool_destroy)
 void destroy_locked_list(LockedList* list) {
-    Node* current = list->head;
-    while (current != NULL) {
-        Node* temp = current;
-        current = current->next;
-        free(temp);
-    }
-    omp_destroy_lock(&list->lock); // Libera recursos do lock
+    list->head = NULL;
+    list->count = 0;
+    plock_destroy(&list->lock); // Libera recursos do lock (os números ficam para o relatório)
 }
 
 // Imprimir lista simples
@@ -110,18 +109,19 @@ void print_locked_list(LockedList* list) {
 // Variáveis globais para as duas listas (necessário para regiões críticas nomeadas)
 SimpleList global_list1, global_list2;
 
+// Travas com perfil que fazem o papel de critical(lista1) e critical(lista2)
+PROFILED_CRITICAL_DEFINE(lista1)
+PROFILED_CRITICAL_DEFINE(lista2)
+
 // Função para inserir na lista 1 usando região crítica nomeada
 void insert_list1_critical(int data) {
     Node* new_node = create_node(data);
     
-    #pragma omp critical(lista1) // Lock específico para lista1 - permite paralelismo com lista2
+    PROFILED_CRITICAL(lista1) // critical(lista1) com perfil de disputa - permite paralelismo com lista2
     {
         new_node->next = global_list1.head;
         global_list1.head = new_node;
         global_list1.count++;
-        
-        // Simula processamento
-        usleep(1000);
     }
 }
 
@@ -129,14 +129,11 @@ void insert_list1_critical(int data) {
 void insert_list2_critical(int data) {
     Node* new_node = create_node(data);
     
-    #pragma omp critical(lista2) // Lock específico para lista2 - independente de lista1
+    PROFILED_CRITICAL(lista2) // critical(lista2) com perfil de disputa - independente de lista1
     {
         new_node->next = global_list2.head;
         global_list2.head = new_node;
         global_list2.count++;
-        
-        // Simula processamento
-        usleep(1000);
     }
 }
 
@@ -145,6 +142,8 @@ void program_two_lists_named_critical(int num_insertions, int num_threads) {
     printf("\n=== DUAS LISTAS COM REGIÕES CRÍTICAS NOMEADAS ===\n");
     printf("Inserções: %d | Threads: %d\n\n", num_insertions, num_threads);
     
+    pool_init(&node_pool, sizeof(Node));
+    
     // Inicializar as duas listas globais
     init_simple_list(&global_list1, 1);
     init_simple_list(&global_list2, 2);
@@ -187,6 +186,7 @@ void program_two_lists_named_critical(int num_insertions, int num_threads) {
     
     destroy_simple_list(&global_list1);
     destroy_simple_list(&global_list2);
+    pool_destroy(&node_pool); // Libera todos os nós das duas listas em O(blocos)
 }
 
 // IMPLEMENTAÇÃO GENERALIZADA COM N LISTAS USANDO LOCKS EXPLÍCITOS
@@ -195,16 +195,13 @@ void program_two_lists_named_critical(int num_insertions, int num_threads) {
 void insert_locked_list(LockedList* list, int data) {
     Node* new_node = create_node(data);
     
-    omp_set_lock(&list->lock); // Adquire lock específico desta lista
+    plock_set(&list->lock); // Adquire lock específico desta lista
     {
         new_node->next = list->head;
         list->head = new_node;
         list->count++;
-        
-        // Simula processamento
-        usleep(1000);
     }
-    omp_unset_lock(&list->lock); // Libera lock específico desta lista
+    plock_unset(&list->lock); // Libera lock específico desta lista
 }
 
 // Programa generalizado para N listas usando locks explícitos
@@ -219,6 +216,8 @@ void program_n_lists_explicit_locks(int num_lists, int num_insertions, int num_t
         exit(1);
     }
     
+    pool_init(&node_pool, sizeof(Node));
+    
     // Inicializa todas as listas
     for (int i = 0; i < num_lists; i++) {
         init_locked_list(&lists[i], i + 1); // Cada lista recebe seu próprio lock
@@ -265,12 +264,23 @@ void program_n_lists_explicit_locks(int num_lists, int num_insertions, int num_t
         destroy_locked_list(&lists[i]); // Destrói lock e libera nós de cada lista
     }
     free(lists); // Libera array de listas
+    pool_destroy(&node_pool); // Libera todos os nós de todas as listas em O(blocos)
 }
 
-int main() {
+int main(int argc, char* argv[]) {
     printf("TAREFA 9: Regiões Críticas Nomeadas vs Locks Explícitos\n");
     printf("========================================================\n");
     
+    if (argc > 1) {
+        int type = lock_type_parse(argv[1]);
+        if (type < 0) {
+            fprintf(stderr, "Trava desconhecida: %s (use omp, ttas, ticket, mcs ou futex)\n", argv[1]);
+            return 1;
+        }
+        list_lock_type = (LockType)type;
+    }
+    printf("Trava das listas: %s\n", lock_type_names[list_lock_type]);
+    
     srand(time(NULL)); // Inicializa gerador de números aleatórios
     
     int num_insertions, num_threads, num_lists;
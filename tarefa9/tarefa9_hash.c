@@ -0,0 +1,305 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <omp.h>
+#include "hash_concorrente.h"
+
+// Tabela hash concorrente (hash_concorrente.h) contra o desenho de program_n_lists_explicit_locks:
+// N listas com um omp_lock_t cada, a chave escolhe a lista. Nas listas, busca, inserção e remoção
+// percorrem a lista inteira com a trava na mão, e as listas só crescem. Na tabela, a busca não
+// trava nada e os baldes se dividem conforme os elementos entram.
+//
+// Cargas mistas com 50%, 90% e 99% de buscas; o resto é metade inserção, metade remoção.
+
+typedef struct Node {
+    int data;
+    int value;
+    struct Node* next;
+} Node;
+
+typedef struct {
+    _Alignas(128) Node* head;
+    long count;
+    omp_lock_t lock;
+} LockedList;
+
+typedef struct {
+    LockedList* lists;
+    int num_lists;
+} NLists;
+
+static Node* create_node(int data, int value, Node* next) {
+    Node* new_node = malloc(sizeof(Node));
+    if (new_node == NULL) {
+        fprintf(stderr, "Erro ao alocar memória para novo nó\n");
+        exit(1);
+    }
+    new_node->data = data;
+    new_node->value = value;
+    new_node->next = next;
+    return new_node;
+}
+
+static LockedList* nlists_pick(NLists* n, int key) {
+    return &n->lists[map_hash(key) % n->num_lists];
+}
+
+static int nlists_lookup(NLists* n, int key, int* value) {
+    LockedList* list = nlists_pick(n, key);
+    omp_set_lock(&list->lock);
+    Node* c = list->head;
+    while (c != NULL && c->data != key) c = c->next;
+    if (c != NULL) *value = c->value;
+    omp_unset_lock(&list->lock);
+    return c != NULL;
+}
+
+static int nlists_insert(NLists* n, int key, int value) {
+    LockedList* list = nlists_pick(n, key);
+    omp_set_lock(&list->lock);
+    Node* c = list->head;
+    while (c != NULL && c->data != key) c = c->next;
+    if (c != NULL) {
+        c->value = value;
+    } else {
+        list->head = create_node(key, value, list->head);
+        list->count++;
+    }
+    omp_unset_lock(&list->lock);
+    return c == NULL;
+}
+
+static int nlists_erase(NLists* n, int key) {
+    LockedList* list = nlists_pick(n, key);
+    omp_set_lock(&list->lock);
+    Node** link = &list->head;
+    while (*link != NULL && (*link)->data != key) link = &(*link)->next;
+    Node* c = *link;
+    if (c != NULL) {
+        *link = c->next;
+        free(c);
+        list->count--;
+    }
+    omp_unset_lock(&list->lock);
+    return c != NULL;
+}
+
+static void nlists_init(NLists* n, int num_lists) {
+    n->num_lists = num_lists;
+    if (posix_memalign((void**)&n->lists, 128, num_lists * sizeof(LockedList)) != 0) {
+        fprintf(stderr, "Erro ao alocar memória para as listas\n");
+        exit(1);
+    }
+    for (int i = 0; i < num_lists; i++) {
+        n->lists[i].head = NULL;
+        n->lists[i].count = 0;
+        omp_init_lock(&n->lists[i].lock);
+    }
+}
+
+static long nlists_size(NLists* n) {
+    long total = 0;
+    for (int i = 0; i < n->num_lists; i++) total += n->lists[i].count;
+    return total;
+}
+
+static void nlists_destroy(NLists* n) {
+    for (int i = 0; i < n->num_lists; i++) {
+        Node* c = n->lists[i].head;
+        while (c != NULL) {
+            Node* next = c->next;
+            free(c);
+            c = next;
+        }
+        omp_destroy_lock(&n->lists[i].lock);
+    }
+    free(n->lists);
+}
+
+// Conferência contra um vetor simples, atravessando vários crescimentos
+static void check_map(void) {
+    enum { KEYS = 20000, OPS = 400000 };
+    int* model = malloc(KEYS * sizeof(int));        // -1: ausente
+    if (model == NULL) {
+        fprintf(stderr, "Erro ao alocar memória para o modelo\n");
+        exit(1);
+    }
+    for (int i = 0; i < KEYS; i++) model[i] = -1;
+    ConcurrentMap* m;
+    if (posix_memalign((void**)&m, 128, sizeof(ConcurrentMap)) != 0) {
+        fprintf(stderr, "Erro ao alocar memória para a tabela\n");
+        exit(1);
+    }
+    map_init(m, 1);
+    unsigned int seed = 42;
+    long present = 0;
+    for (int i = 0; i < OPS; i++) {
+        int key = rand_r(&seed) % KEYS, op = rand_r(&seed) % 3, v = 0;
+        int ok;
+        if (op == 0) {
+            ok = map_insert(m, key, i) == (model[key] < 0);
+            present += model[key] < 0;
+            model[key] = i;
+        } else if (op == 1) {
+            ok = map_erase(m, key) == (model[key] >= 0);
+            present -= model[key] >= 0;
+            model[key] = -1;
+        } else {
+            int found = map_lookup(m, key, &v);
+            ok = found == (model[key] >= 0) && (!found || v == model[key]);
+        }
+        if (!ok) {
+            fprintf(stderr, "Tabela hash diverge do modelo na operação %d\n", i);
+            exit(1);
+        }
+    }
+    if (map_size(m) != present) {
+        fprintf(stderr, "Tabela hash: %ld elementos, esperado %ld\n", map_size(m), present);
+        exit(1);
+    }
+    printf("Conferência sequencial: %d operações iguais ao modelo, %d crescimentos\n", OPS,
+           atomic_load(&m->resizes));
+    map_destroy(m);
+
+    // Concorrente: cada thread só escreve nas chaves k com k % t == tid e confere as próprias
+    // buscas contra o modelo, enquanto as outras threads dividem os mesmos baldes e migrações
+    for (int i = 0; i < KEYS; i++) model[i] = -1;
+    map_init(m, 1);
+    int t = omp_get_max_threads(), errors = 0;
+    #pragma omp parallel num_threads(t) reduction(+:errors)
+    {
+        int tid = omp_get_thread_num();
+        unsigned int local_seed = 99u + tid;
+        for (int i = 0; i < OPS / t; i++) {
+            int key = (rand_r(&local_seed) % (KEYS / t)) * t + tid, op = rand_r(&local_seed) % 3, v = 0;
+            if (op == 0) {
+                errors += map_insert(m, key, i) != (model[key] < 0);
+                model[key] = i;
+            } else if (op == 1) {
+                errors += map_erase(m, key) != (model[key] >= 0);
+                model[key] = -1;
+            } else {
+                int found = map_lookup(m, key, &v);
+                errors += found != (model[key] >= 0) || (found && v != model[key]);
+            }
+        }
+    }
+    present = 0;
+    for (int i = 0; i < KEYS; i++) present += model[i] >= 0;
+    if (errors > 0 || map_size(m) != present) {
+        fprintf(stderr, "Tabela hash concorrente: %d divergências, %ld elementos (esperado %ld)\n", errors,
+                map_size(m), present);
+        exit(1);
+    }
+    printf("Conferência concorrente (%d threads): nenhuma divergência, %d crescimentos\n", t,
+           atomic_load(&m->resizes));
+    map_destroy(m);
+
+    // Crescimento concorrente: as threads inserem GROW_KEYS chaves distintas a partir de uma
+    // tabela mínima, então dezenas de trocas de tabela acontecem com escritas em andamento. Pelo
+    // menos 4 threads, para que elas se intercalem mesmo com poucos núcleos
+    enum { GROW_KEYS = 2000000 };
+    int tg = t < 4 ? 4 : t;
+    map_init(m, 1);
+    errors = 0;
+    #pragma omp parallel num_threads(tg) reduction(+:errors)
+    {
+        int tid = omp_get_thread_num(), nt = omp_get_num_threads();
+        for (int k = tid; k < GROW_KEYS; k += nt) errors += map_insert(m, k, k + 1) != 1;
+        #pragma omp barrier
+        for (int k = tid; k < GROW_KEYS; k += nt) {       // Remove as ímpares e confere todas
+            if (k % 2 == 1) errors += map_erase(m, k) != 1;
+            int v = 0, found = map_lookup(m, k, &v);
+            errors += k % 2 == 1 ? found : (!found || v != k + 1);
+        }
+    }
+    if (errors > 0 || map_size(m) != GROW_KEYS / 2) {
+        fprintf(stderr, "Tabela hash em crescimento: %d divergências, %ld elementos (esperado %d)\n", errors,
+                map_size(m), GROW_KEYS / 2);
+        exit(1);
+    }
+    printf("Crescimento concorrente (%d threads, %d chaves): nenhuma divergência, %d crescimentos\n\n", tg,
+           GROW_KEYS, atomic_load(&m->resizes));
+    map_destroy(m);
+    free(m);
+    free(model);
+}
+
+// Milhões de operações por segundo; confere que o tamanho final = inicial + inserções - remoções
+static double run_mixed(int use_map, int num_lists, long ops, int keys, int read_pct, int t, size_t* buckets) {
+    ConcurrentMap* m = NULL;
+    NLists n;
+    if (use_map) {
+        if (posix_memalign((void**)&m, 128, sizeof(ConcurrentMap)) != 0) {
+            fprintf(stderr, "Erro ao alocar memória para a tabela\n");
+            exit(1);
+        }
+        map_init(m, 1);
+    } else {
+        nlists_init(&n, num_lists);
+    }
+    for (int k = 0; k < keys; k += 2) {               // Metade das chaves presente no início
+        if (use_map) map_insert(m, k, k);
+        else nlists_insert(&n, k, k);
+    }
+    long initial = (keys + 1) / 2, delta = 0;
+
+    double t0 = omp_get_wtime();
+    #pragma omp parallel num_threads(t) reduction(+:delta)
+    {
+        unsigned int seed = 777u + omp_get_thread_num();
+        #pragma omp for schedule(static)
+        for (long i = 0; i < ops; i++) {
+            int key = rand_r(&seed) % keys, r = rand_r(&seed) % 100, v;
+            if (r < read_pct) {
+                if (use_map) map_lookup(m, key, &v);
+                else nlists_lookup(&n, key, &v);
+            } else if ((r - read_pct) % 2 == 0) {
+                delta += use_map ? map_insert(m, key, (int)i) : nlists_insert(&n, key, (int)i);
+            } else {
+                delta -= use_map ? map_erase(m, key) : nlists_erase(&n, key);
+            }
+        }
+    }
+    double t1 = omp_get_wtime();
+
+    long size = use_map ? map_size(m) : nlists_size(&n);
+    if (size != initial + delta) {
+        fprintf(stderr, "%s: %ld elementos, esperado %ld\n", use_map ? "Tabela" : "Listas", size, initial + delta);
+        exit(1);
+    }
+    if (use_map) {
+        *buckets = atomic_load(&m->cur)->size;
+        map_destroy(m);
+        free(m);
+    } else {
+        *buckets = num_lists;
+        nlists_destroy(&n);
+    }
+    return ops / (t1 - t0) / 1e6;
+}
+
+int main(int argc, char* argv[]) {
+    long ops = (argc > 1) ? atol(argv[1]) : 500000;
+    int keys = (argc > 2) ? atoi(argv[2]) : 4096;
+    int num_lists = (argc > 3) ? atoi(argv[3]) : 16;
+    int max_threads = omp_get_max_threads();
+    int read_pcts[] = { 50, 90, 99 };
+
+    check_map();
+
+    printf("Cargas mistas: %ld operações, %d chaves (metade presente no início), %d listas\n\n", ops, keys,
+           num_lists);
+    printf("%7s %8s %15s %15s %10s\n", "Threads", "Buscas", "N listas Mops/s", "Tabela Mops/s", "Baldes");
+    for (int t = 1; ; t = (t * 2 < max_threads) ? t * 2 : max_threads) {
+        for (int p = 0; p < 3; p++) {
+            size_t bl, bm;
+            double l = run_mixed(0, num_lists, ops, keys, read_pcts[p], t, &bl);
+            double mm = run_mixed(1, num_lists, ops, keys, read_pcts[p], t, &bm);
+            printf("%7d %7d%% %15.2f %15.2f %10zu\n", t, read_pcts[p], l, mm, bm);
+        }
+        if (t == max_threads) break;
+    }
+    return 0;
+}
+
+// Compilar: gcc -O2 -fopenmp tarefa9_hash.c -o tarefa9_hash
@@ -0,0 +1,215 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <omp.h>
+#include "treiber_ebr.h"
+
+// Inserção na cabeça sem trava (pilha de Treiber) contra as duas versões de tarefa9.c:
+// região crítica nomeada e omp_lock_t. Todas as threads inserem na mesma lista, que é o
+// caso de maior contenção. O nó é alocado dentro do laço medido nas três versões, como
+// em create_node.
+//
+// Depois, uma carga mista (push, pop e percurso concorrentes) confere que nenhum elemento
+// se perde e que a memória retirada é liberada pelas épocas.
+
+typedef struct Node {
+    int data;
+    struct Node* next;
+} Node;
+
+typedef struct {
+    Node* head;
+    long count;
+} SimpleList;
+
+typedef struct {
+    Node* head;
+    long count;
+    omp_lock_t lock;
+} LockedList;
+
+static SimpleList critical_list;
+
+static Node* create_node(int data) {
+    Node* new_node = malloc(sizeof(Node));
+    if (new_node == NULL) {
+        fprintf(stderr, "Erro ao alocar memória para novo nó\n");
+        exit(1);
+    }
+    new_node->data = data;
+    new_node->next = NULL;
+    return new_node;
+}
+
+static void free_nodes(Node* n) {
+    while (n != NULL) {
+        Node* next = n->next;
+        free(n);
+        n = next;
+    }
+}
+
+static void insert_critical(int data) {
+    Node* new_node = create_node(data);
+    #pragma omp critical(lista1)
+    {
+        new_node->next = critical_list.head;
+        critical_list.head = new_node;
+        critical_list.count++;
+    }
+}
+
+static void insert_locked(LockedList* list, int data) {
+    Node* new_node = create_node(data);
+    omp_set_lock(&list->lock);
+    new_node->next = list->head;
+    list->head = new_node;
+    list->count++;
+    omp_unset_lock(&list->lock);
+}
+
+static void insert_treiber(TreiberStack* s, int data) {
+    TreiberNode* new_node = malloc(sizeof(TreiberNode));
+    if (new_node == NULL) {
+        fprintf(stderr, "Erro ao alocar memória para novo nó\n");
+        exit(1);
+    }
+    new_node->data = data;
+    treiber_push(s, new_node);
+}
+
+// Inserções por segundo (milhões) de cada versão com t threads; confere a contagem e a soma
+static void bench_insert(long n, int t, double* mcritical, double* mlocked, double* mtreiber) {
+    long long expected = (long long)n * (n - 1) / 2;
+
+    critical_list.head = NULL;
+    critical_list.count = 0;
+    double t0 = omp_get_wtime();
+    #pragma omp parallel for num_threads(t) schedule(static)
+    for (long i = 0; i < n; i++) insert_critical((int)i);
+    double t1 = omp_get_wtime();
+    long long sum = 0;
+    for (Node* c = critical_list.head; c != NULL; c = c->next) sum += c->data;
+    if (critical_list.count != n || sum != expected) {
+        fprintf(stderr, "Região crítica: %ld elementos, soma %lld (esperado %ld, %lld)\n",
+                critical_list.count, sum, n, expected);
+        exit(1);
+    }
+    free_nodes(critical_list.head);
+    *mcritical = n / (t1 - t0) / 1e6;
+
+    LockedList locked;
+    locked.head = NULL;
+    locked.count = 0;
+    omp_init_lock(&locked.lock);
+    t0 = omp_get_wtime();
+    #pragma omp parallel for num_threads(t) schedule(static)
+    for (long i = 0; i < n; i++) insert_locked(&locked, (int)i);
+    t1 = omp_get_wtime();
+    sum = 0;
+    for (Node* c = locked.head; c != NULL; c = c->next) sum += c->data;
+    if (locked.count != n || sum != expected) {
+        fprintf(stderr, "omp_lock_t: %ld elementos, soma %lld (esperado %ld, %lld)\n",
+                locked.count, sum, n, expected);
+        exit(1);
+    }
+    free_nodes(locked.head);
+    omp_destroy_lock(&locked.lock);
+    *mlocked = n / (t1 - t0) / 1e6;
+
+    TreiberStack* s;
+    if (posix_memalign((void**)&s, EBR_LINHA, sizeof(TreiberStack)) != 0) {
+        fprintf(stderr, "Erro ao alocar memória para a pilha\n");
+        exit(1);
+    }
+    treiber_init(s);
+    t0 = omp_get_wtime();
+    #pragma omp parallel for num_threads(t) schedule(static)
+    for (long i = 0; i < n; i++) insert_treiber(s, (int)i);
+    t1 = omp_get_wtime();
+    long visited;
+    sum = treiber_sum(s, -1, &visited);
+    if (visited != n || sum != expected) {
+        fprintf(stderr, "Treiber: %ld elementos, soma %lld (esperado %ld, %lld)\n", visited, sum, n, expected);
+        exit(1);
+    }
+    treiber_destroy(s, NULL, NULL);
+    free(s);
+    *mtreiber = n / (t1 - t0) / 1e6;
+}
+
+// Carga mista: cada thread alterna push e pop e, a cada 256 operações, percorre os
+// primeiros 64 nós. Ao final, soma dos empilhados = soma dos desempilhados + soma restante.
+static void bench_mixed(long ops, int t) {
+    TreiberStack* s;
+    if (posix_memalign((void**)&s, EBR_LINHA, sizeof(TreiberStack)) != 0) {
+        fprintf(stderr, "Erro ao alocar memória para a pilha\n");
+        exit(1);
+    }
+    treiber_init(s);
+    long long pushed = 0, popped = 0, traversed = 0;
+    long pops = 0;
+
+    double t0 = omp_get_wtime();
+    #pragma omp parallel num_threads(t) reduction(+:pushed, popped, traversed, pops)
+    {
+        int tid = omp_get_thread_num();
+        long mine = ops / t + (tid < ops % t);
+        for (long i = 0; i < mine; i++) {
+            if ((i & 1) == 0) {
+                int v = (int)(i ^ tid) & 0xffff;
+                insert_treiber(s, v);
+                pushed += v;
+            } else {
+                int v;
+                if (treiber_pop(s, &v)) {
+                    popped += v;
+                    pops++;
+                }
+            }
+            if ((i & 255) == 255) {
+                long visited;
+                treiber_sum(s, 64, &visited);
+                traversed += visited;
+            }
+        }
+    }
+    double t1 = omp_get_wtime();
+
+    long remaining;
+    long long rest = treiber_sum(s, -1, &remaining);
+    unsigned long retired, freed_during;
+    treiber_destroy(s, &retired, &freed_during);
+    free(s);
+    if (pushed != popped + rest || (unsigned long)pops != retired) {
+        fprintf(stderr, "Carga mista com %d threads: elementos perdidos\n", t);
+        exit(1);
+    }
+    printf("%7d %12.2f %12ld %12lu %14lu %12lld\n", t, ops / (t1 - t0) / 1e6, remaining, retired,
+           freed_during, traversed);
+}
+
+int main(int argc, char* argv[]) {
+    long n = (argc > 1) ? atol(argv[1]) : 2000000;
+    int max_threads = omp_get_max_threads();
+
+    printf("Inserções concorrentes na mesma lista: %ld por rodada, até %d threads\n\n", n, max_threads);
+    printf("%7s %16s %16s %16s\n", "Threads", "critical Mins/s", "omp_lock Mins/s", "Treiber Mins/s");
+    for (int t = 1; ; t = (t * 2 < max_threads) ? t * 2 : max_threads) {
+        double mc, ml, mt;
+        bench_insert(n, t, &mc, &ml, &mt);
+        printf("%7d %16.2f %16.2f %16.2f\n", t, mc, ml, mt);
+        if (t == max_threads) break;
+    }
+
+    printf("\nCarga mista na pilha de Treiber (push/pop alternados + percurso): %ld operações\n\n", n);
+    printf("%7s %12s %12s %12s %14s %12s\n", "Threads", "Mops/s", "Restantes", "Retirados",
+           "Liberados_dur", "Percorridos");
+    for (int t = 1; ; t = (t * 2 < max_threads) ? t * 2 : max_threads) {
+        bench_mixed(n, t);
+        if (t == max_threads) break;
+    }
+    printf("\nNenhum elemento perdido; todos os nós retirados foram liberados.\n");
+    return 0;
+}
+
+// Compilar: gcc -O2 -fopenmp tarefa9_lockfree.c -o tarefa9_lockfree
@@ -0,0 +1,125 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <omp.h>
+#include "perfil_travas.h"
+
+// Custo do perfil de travas (perfil_travas.h) e exemplo do relatório
+//
+// 1. Sem disputa (uma thread): ns por par aquisição+liberação de omp_lock_t, ProfiledLock,
+//    critical nomeada e PROFILED_CRITICAL
+// 2. Com disputa: todas as threads inserem em poucas listas; o relatório sai no fim do programa
+//    (PERFIL_TRAVAS_JSON=arquivo grava também em JSON)
+
+typedef struct Node {
+    int data;
+    struct Node* next;
+} Node;
+
+typedef struct {
+    _Alignas(128) Node* head;
+    long count;
+    ProfiledLock lock;
+} LockedList;
+
+PROFILED_CRITICAL_DEFINE(contador)
+
+static volatile long counter;
+
+int main(int argc, char* argv[]) {
+    long n = (argc > 1) ? atol(argv[1]) : 20000000;
+    int num_lists = (argc > 2) ? atoi(argv[2]) : 4;
+
+    printf("Sem disputa: %ld aquisições por versão (ns por aquisição+liberação)\n\n", n);
+    omp_lock_t plain;
+    omp_init_lock(&plain);
+    double t0 = omp_get_wtime();
+    for (long i = 0; i < n; i++) {
+        omp_set_lock(&plain);
+        counter++;
+        omp_unset_lock(&plain);
+    }
+    double t_plain = omp_get_wtime() - t0;
+    omp_destroy_lock(&plain);
+
+    ProfiledLock profiled;
+    plock_init(&profiled, "sem disputa");
+    t0 = omp_get_wtime();
+    for (long i = 0; i < n; i++) {
+        plock_set(&profiled);
+        counter++;
+        plock_unset(&profiled);
+    }
+    double t_profiled = omp_get_wtime() - t0;
+    plock_destroy(&profiled);
+
+    t0 = omp_get_wtime();
+    for (long i = 0; i < n; i++) {
+        #pragma omp critical(contador_original)
+        counter++;
+    }
+    double t_critical = omp_get_wtime() - t0;
+
+    t0 = omp_get_wtime();
+    for (long i = 0; i < n; i++) {
+        PROFILED_CRITICAL(contador) {
+            counter++;
+        }
+    }
+    double t_pcritical = omp_get_wtime() - t0;
+
+    printf("%-22s %8.2f\n", "omp_lock_t", t_plain / n * 1e9);
+    printf("%-22s %8.2f  (+%.2f)\n", "ProfiledLock", t_profiled / n * 1e9, (t_profiled - t_plain) / n * 1e9);
+    printf("%-22s %8.2f\n", "critical(nome)", t_critical / n * 1e9);
+    printf("%-22s %8.2f  (+%.2f)\n", "PROFILED_CRITICAL", t_pcritical / n * 1e9,
+           (t_pcritical - t_critical) / n * 1e9);
+
+    // Com disputa: como program_n_lists_explicit_locks, com poucas listas
+    LockedList* lists;
+    if (posix_memalign((void**)&lists, 128, num_lists * sizeof(LockedList)) != 0) {
+        fprintf(stderr, "Erro ao alocar memória para as listas\n");
+        exit(1);
+    }
+    for (int i = 0; i < num_lists; i++) {
+        char name[32];
+        snprintf(name, sizeof(name), "lista %d", i + 1);
+        lists[i].head = NULL;
+        lists[i].count = 0;
+        plock_init(&lists[i].lock, name);
+    }
+    long inserts = n / 10;
+    t0 = omp_get_wtime();
+    #pragma omp parallel
+    {
+        unsigned int seed = 31u + omp_get_thread_num();
+        #pragma omp for schedule(static)
+        for (long i = 0; i < inserts; i++) {
+            LockedList* list = &lists[rand_r(&seed) % num_lists];
+            Node* new_node = malloc(sizeof(Node));
+            if (new_node == NULL) {
+                fprintf(stderr, "Erro ao alocar memória para novo nó\n");
+                exit(1);
+            }
+            new_node->data = (int)i;
+            plock_set(&list->lock);
+            new_node->next = list->head;
+            list->head = new_node;
+            list->count++;
+            plock_unset(&list->lock);
+        }
+    }
+    printf("\nCom disputa: %ld inserções em %d listas, %d threads, %.3f s\n", inserts, num_lists,
+           omp_get_max_threads(), omp_get_wtime() - t0);
+    for (int i = 0; i < num_lists; i++) {
+        Node* c = lists[i].head;
+        while (c != NULL) {
+            Node* next = c->next;
+            free(c);
+            c = next;
+        }
+        plock_destroy(&lists[i].lock);
+    }
+    free(lists);
+    return 0;   // O relatório por trava é impresso na saída (atexit)
+}
+
+// Compilar: gcc -O2 -fopenmp tarefa9_perfil.c -o tarefa9_perfil
@@ -0,0 +1,171 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <omp.h>
+#include "pool_nos.h"
+
+// Pool de nós por thread (pool_nos.h) contra malloc/free
+//
+// 1. Alocações por segundo: cada thread aloca e libera os próprios nós (caso local) e, depois,
+//    libera os nós alocados pela thread vizinha (caso remoto, que passa pela fila de liberações)
+// 2. Inserções por segundo em N listas com omp_lock_t, como em program_n_lists_explicit_locks,
+//    e o tempo de descartar todas as listas: free nó a nó contra pool_destroy
+
+typedef struct Node {
+    int data;
+    struct Node* next;
+} Node;
+
+// Uma lista por linha de cache: sem isso, as travas de listas vizinhas dividem linhas e o
+// resultado passa a depender de onde o malloc colocou o vetor de listas
+typedef struct {
+    _Alignas(128) Node* head;
+    long count;
+    omp_lock_t lock;
+} LockedList;
+
+#define ROUNDS 4
+
+static NodePool node_pool;
+static int use_pool;
+
+static Node* create_node(int data) {
+    Node* new_node;
+    if (use_pool) {
+        new_node = pool_alloc(&node_pool);
+    } else {
+        new_node = malloc(sizeof(Node));
+        if (new_node == NULL) {
+            fprintf(stderr, "Erro ao alocar memória para novo nó\n");
+            exit(1);
+        }
+    }
+    new_node->data = data;
+    new_node->next = NULL;
+    return new_node;
+}
+
+static void release_node(Node* n) {
+    if (use_pool) pool_free(&node_pool, n);
+    else free(n);
+}
+
+// Milhões de alocações+liberações por segundo. remote = 1: cada thread libera o que a
+// thread seguinte alocou
+static double bench_alloc(long n, int t, int remote) {
+    Node** slots = malloc(n * sizeof(Node*));
+    if (slots == NULL) {
+        fprintf(stderr, "Erro ao alocar memória para os ponteiros\n");
+        exit(1);
+    }
+    if (use_pool) pool_init(&node_pool, sizeof(Node));
+    double t0 = omp_get_wtime();
+    #pragma omp parallel num_threads(t)
+    {
+        int tid = omp_get_thread_num();
+        long mine = n / t;
+        for (int r = 0; r < ROUNDS; r++) {
+            Node** own = slots + tid * mine;
+            for (long i = 0; i < mine; i++) own[i] = create_node((int)i);
+            #pragma omp barrier
+            Node** other = remote ? slots + ((tid + 1) % t) * mine : own;
+            for (long i = 0; i < mine; i++) release_node(other[i]);
+            #pragma omp barrier
+        }
+    }
+    double t1 = omp_get_wtime();
+    if (use_pool) pool_destroy(&node_pool);
+    free(slots);
+    return (double)(n / t) * t * ROUNDS / (t1 - t0) / 1e6;
+}
+
+// Milhões de inserções por segundo em num_lists listas; *teardown recebe o tempo de descarte
+static double bench_insert(long n, int num_lists, int t, double* teardown) {
+    LockedList* lists;
+    if (posix_memalign((void**)&lists, 128, num_lists * sizeof(LockedList)) != 0) {
+        fprintf(stderr, "Erro ao alocar memória para as listas\n");
+        exit(1);
+    }
+    for (int i = 0; i < num_lists; i++) {
+        lists[i].head = NULL;
+        lists[i].count = 0;
+        omp_init_lock(&lists[i].lock);
+    }
+    if (use_pool) pool_init(&node_pool, sizeof(Node));
+
+    double t0 = omp_get_wtime();
+    #pragma omp parallel num_threads(t)
+    {
+        unsigned int seed = 1234u + omp_get_thread_num();
+        #pragma omp for schedule(static)
+        for (long i = 0; i < n; i++) {
+            LockedList* list = &lists[rand_r(&seed) % num_lists];
+            Node* new_node = create_node((int)i);
+            omp_set_lock(&list->lock);
+            new_node->next = list->head;
+            list->head = new_node;
+            list->count++;
+            omp_unset_lock(&list->lock);
+        }
+    }
+    double t1 = omp_get_wtime();
+
+    long total = 0;
+    for (int i = 0; i < num_lists; i++) total += lists[i].count;
+    if (total != n) {
+        fprintf(stderr, "Inserções perdidas: %ld de %ld\n", total, n);
+        exit(1);
+    }
+
+    double t2 = omp_get_wtime();
+    if (use_pool) {
+        pool_destroy(&node_pool);
+    } else {
+        for (int i = 0; i < num_lists; i++) {
+            Node* current = lists[i].head;
+            while (current != NULL) {
+                Node* temp = current;
+                current = current->next;
+                free(temp);
+            }
+        }
+    }
+    *teardown = omp_get_wtime() - t2;
+    for (int i = 0; i < num_lists; i++) omp_destroy_lock(&lists[i].lock);
+    free(lists);
+    return n / (t1 - t0) / 1e6;
+}
+
+int main(int argc, char* argv[]) {
+    long n = (argc > 1) ? atol(argv[1]) : 1000000;
+    int num_lists = (argc > 2) ? atoi(argv[2]) : 8;
+    int max_threads = omp_get_max_threads();
+
+    printf("Alocações por segundo (milhões): %ld nós por rodada, %d rodadas\n\n", n, ROUNDS);
+    printf("%7s %14s %14s %14s %14s\n", "Threads", "malloc local", "pool local", "malloc remoto",
+           "pool remoto");
+    for (int t = 1; ; t = (t * 2 < max_threads) ? t * 2 : max_threads) {
+        double r[4];
+        for (int k = 0; k < 4; k++) {
+            use_pool = k & 1;
+            r[k] = bench_alloc(n, t, k >> 1);
+        }
+        printf("%7d %14.2f %14.2f %14.2f %14.2f\n", t, r[0], r[1], r[2], r[3]);
+        if (t == max_threads) break;
+    }
+
+    printf("\nInserções em %d listas com omp_lock_t: %ld inserções\n\n", num_lists, n);
+    printf("%7s %15s %15s %15s %15s\n", "Threads", "malloc Mins/s", "pool Mins/s", "free nos (ms)",
+           "pool_destroy ms");
+    for (int t = 1; ; t = (t * 2 < max_threads) ? t * 2 : max_threads) {
+        double tm, tp;
+        use_pool = 0;
+        double m = bench_insert(n, num_lists, t, &tm);
+        use_pool = 1;
+        double p = bench_insert(n, num_lists, t, &tp);
+        printf("%7d %15.2f %15.2f %15.2f %15.3f\n", t, m, p, tm * 1e3, tp * 1e3);
+        if (t == max_threads) break;
+    }
+    return 0;
+}
+
+// Compilar: gcc -O2 -fopenmp tarefa9_pool.c -o tarefa9_pool
@@ -0,0 +1,123 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <omp.h>
+#include "travas.h"
+
+// Vazão e justiça das travas de travas.h (omp, ttas, ticket, mcs, futex)
+//
+// Cada thread repete, por um tempo fixo: adquire a trava, insere um nó na lista compartilhada e
+// faz 'trabalho' iterações dentro da seção crítica, libera e faz um pouco de trabalho fora.
+// Vazão: aquisições por segundo. Justiça: coeficiente de variação das aquisições por thread
+// (desvio padrão / média; 0 = todas as threads adquiriram o mesmo número de vezes).
+// A contagem da lista confere a exclusão mútua.
+
+typedef struct Node {
+    int data;
+    struct Node* next;
+} Node;
+
+typedef struct {
+    _Alignas(128) Node* head;
+    long count;
+    Lock lock;
+} LockedList;
+
+#define FORA 50                 // Iterações de trabalho fora da seção crítica
+
+static volatile double sink;
+
+static inline void work(int iterations, double* x) {
+    for (int i = 0; i < iterations; i++) *x = *x * 1.0000001 + 1e-9;
+}
+
+// Devolve milhões de aquisições por segundo e, em *cv, o coeficiente de variação por thread
+static double run(LockType type, int t, int cs_work, double seconds, double* cv) {
+    LockedList list;
+    list.head = NULL;
+    list.count = 0;
+    lock_init(&list.lock, type);
+    long* per_thread = calloc(t, sizeof(long));
+    if (per_thread == NULL) {
+        fprintf(stderr, "Erro ao alocar memória para os contadores\n");
+        exit(1);
+    }
+    atomic_int stop = 0;
+
+    double t0 = omp_get_wtime();
+    #pragma omp parallel num_threads(t)
+    {
+        int tid = omp_get_thread_num();
+        double x = tid;
+        long mine = 0;
+        while (!atomic_load_explicit(&stop, memory_order_relaxed)) {
+            Node* new_node = malloc(sizeof(Node));
+            if (new_node == NULL) {
+                fprintf(stderr, "Erro ao alocar memória para novo nó\n");
+                exit(1);
+            }
+            new_node->data = tid;
+            lock_acquire(&list.lock);
+            new_node->next = list.head;
+            list.head = new_node;
+            list.count++;
+            work(cs_work, &x);
+            lock_release(&list.lock);
+            mine++;
+            work(FORA, &x);
+            if ((mine & 63) == 0 && tid == 0 && omp_get_wtime() - t0 >= seconds) atomic_store(&stop, 1);
+        }
+        per_thread[tid] = mine;
+        sink = x;
+    }
+    double elapsed = omp_get_wtime() - t0;
+
+    long total = 0;
+    for (int i = 0; i < t; i++) total += per_thread[i];
+    if (list.count != total) {
+        fprintf(stderr, "%s: lista com %ld nós, %ld aquisições (exclusão mútua violada)\n", lock_type_names[type],
+                list.count, total);
+        exit(1);
+    }
+    double mean = (double)total / t, var = 0;
+    for (int i = 0; i < t; i++) var += (per_thread[i] - mean) * (per_thread[i] - mean);
+    *cv = mean > 0 ? sqrt(var / t) / mean : 0;
+
+    Node* c = list.head;
+    while (c != NULL) {
+        Node* next = c->next;
+        free(c);
+        c = next;
+    }
+    lock_destroy(&list.lock);
+    free(per_thread);
+    return total / elapsed / 1e6;
+}
+
+int main(int argc, char* argv[]) {
+    double seconds = (argc > 1) ? atof(argv[1]) : 0.1;
+    int max_threads = omp_get_max_threads();
+    int cs_works[] = { 0, 100, 1000 };
+
+    printf("Travas: vazão (M aquisições/s) e justiça (CV das aquisições por thread), %.2f s por medida\n",
+           seconds);
+    for (int w = 0; w < 3; w++) {
+        printf("\nTrabalho na seção crítica: %d iterações (fora: %d)\n\n", cs_works[w], FORA);
+        printf("%7s", "Threads");
+        for (int k = 0; k < LOCK_NUM_TYPES; k++) printf(" %8s %6s", lock_type_names[k], "CV");
+        printf("\n");
+        for (int t = 1; ; t = (t * 2 < max_threads) ? t * 2 : max_threads) {
+            printf("%7d", t);
+            for (int k = 0; k < LOCK_NUM_TYPES; k++) {
+                double cv, m = run((LockType)k, t, cs_works[w], seconds, &cv);
+                printf(" %8.2f %6.3f", m, cv);
+                fflush(stdout);
+            }
+            printf("\n");
+            if (t == max_threads) break;
+        }
+    }
+    return 0;
+}
+
+// Compilar: gcc -O2 -fopenmp tarefa9_travas.c -o tarefa9_travas -lm
@@ -0,0 +1,239 @@
+#ifndef TRAVAS_H
+#define TRAVAS_H
+
+// Travas intercambiáveis: a mesma interface para omp_lock_t e quatro implementações próprias
+//
+// - LOCK_OMP: omp_lock_t (referência)
+// - LOCK_TTAS: test-and-test-and-set com espera exponencial. Gira lendo (sem escrever na linha)
+//   e só tenta a troca quando a trava parece livre
+// - LOCK_TICKET: senha e painel. Justa (ordem de chegada), mas todas as threads em espera
+//   leem o mesmo painel
+// - LOCK_MCS: fila de nós, cada thread gira no próprio nó. Justa e sem tráfego no painel
+//   comum; o nó vem de uma pilha por thread (aninhamento até TRAVA_MCS_ANINHAMENTO, liberando
+//   na ordem inversa)
+// - LOCK_FUTEX: gira um pouco e depois dorme no kernel (futex), como um mutex adaptativo
+//
+// As travas que giram cedem o processador (sched_yield) depois de TRAVA_GIROS_ATE_YIELD voltas
+// (TTAS: quando a espera chega ao máximo): com mais threads que núcleos, quem está com a trava
+// pode estar fora do processador.
+// O tipo é escolhido em lock_init; as chamadas passam por um switch (previsível e inlinável).
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdatomic.h>
+#include <sched.h>
+#include <unistd.h>
+#include <omp.h>
+#include <linux/futex.h>
+#include <sys/syscall.h>
+
+#define TRAVA_GIROS_ATE_YIELD 64
+#define TRAVA_BACKOFF_MAX 1024
+#define TRAVA_FUTEX_GIROS 100
+#define TRAVA_MCS_ANINHAMENTO 8
+
+typedef enum { LOCK_OMP, LOCK_TTAS, LOCK_TICKET, LOCK_MCS, LOCK_FUTEX, LOCK_NUM_TYPES } LockType;
+
+static const char *const lock_type_names[LOCK_NUM_TYPES] = { "omp", "ttas", "ticket", "mcs", "futex" };
+
+typedef struct McsNode {
+    _Atomic(struct McsNode *) next;
+    atomic_int waiting;
+} McsNode;
+
+typedef struct {
+    LockType type;
+    union {
+        omp_lock_t omp;
+        atomic_int busy;                                   // TTAS e futex (0 livre, 1 ocupada, 2 com espera)
+        struct {
+            atomic_uint next_ticket;
+            atomic_uint now_serving;
+        } ticket;
+        _Atomic(McsNode *) tail;
+    };
+} Lock;
+
+static __thread McsNode lock_mcs_nodes[TRAVA_MCS_ANINHAMENTO];
+static __thread int lock_mcs_depth = 0;
+
+static inline void lock_pause(void) {
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_ia32_pause();
+#endif
+}
+
+// Uma volta de espera: pausa e, a cada TRAVA_GIROS_ATE_YIELD voltas, cede o processador
+static inline void lock_spin(unsigned *spins) {
+    if (++*spins % TRAVA_GIROS_ATE_YIELD == 0) sched_yield();
+    else lock_pause();
+}
+
+// Nome -> tipo; -1 se desconhecido
+static inline int lock_type_parse(const char *name) {
+    for (int i = 0; i < LOCK_NUM_TYPES; i++) {
+        if (strcmp(name, lock_type_names[i]) == 0) return i;
+    }
+    return -1;
+}
+
+static inline void lock_init(Lock *l, LockType type) {
+    l->type = type;
+    switch (type) {
+    case LOCK_OMP: omp_init_lock(&l->omp); break;
+    case LOCK_TTAS:
+    case LOCK_FUTEX: atomic_init(&l->busy, 0); break;
+    case LOCK_TICKET:
+        atomic_init(&l->ticket.next_ticket, 0);
+        atomic_init(&l->ticket.now_serving, 0);
+        break;
+    case LOCK_MCS: atomic_init(&l->tail, NULL); break;
+    default:
+        fprintf(stderr, "Tipo de trava inválido: %d\n", (int)type);
+        exit(1);
+    }
+}
+
+static inline void lock_destroy(Lock *l) {
+    if (l->type == LOCK_OMP) omp_destroy_lock(&l->omp);
+}
+
+static inline long lock_futex(atomic_int *addr, int op, int val) {
+    return syscall(SYS_futex, (int *)addr, op, val, NULL, NULL, 0);
+}
+
+// ---------------------------------------------------------------------------
+// Implementações
+// ---------------------------------------------------------------------------
+static inline void lock_ttas_acquire(Lock *l) {
+    unsigned backoff = 1;
+    for (;;) {
+        if (atomic_load_explicit(&l->busy, memory_order_relaxed) == 0 &&
+            atomic_exchange_explicit(&l->busy, 1, memory_order_acquire) == 0) return;
+        for (unsigned i = 0; i < backoff; i++) lock_pause();
+        if (backoff < TRAVA_BACKOFF_MAX) backoff *= 2;
+        else sched_yield();                              // Espera máxima: quem está com a trava pode estar parado
+    }
+}
+
+static inline void lock_ticket_acquire(Lock *l) {
+    unsigned mine = atomic_fetch_add_explicit(&l->ticket.next_ticket, 1, memory_order_relaxed);
+    unsigned spins = 0, serving;
+    while ((serving = atomic_load_explicit(&l->ticket.now_serving, memory_order_acquire)) != mine) {
+        for (unsigned i = 1; i < mine - serving && i < 64; i++) lock_pause();   // Espera proporcional à fila
+        lock_spin(&spins);
+    }
+}
+
+static inline McsNode *lock_mcs_push_node(void) {
+    if (lock_mcs_depth == TRAVA_MCS_ANINHAMENTO) {
+        fprintf(stderr, "Trava MCS: mais de %d travas aninhadas\n", TRAVA_MCS_ANINHAMENTO);
+        exit(1);
+    }
+    McsNode *n = &lock_mcs_nodes[lock_mcs_depth++];
+    atomic_store_explicit(&n->next, NULL, memory_order_relaxed);
+    atomic_store_explicit(&n->waiting, 1, memory_order_relaxed);
+    return n;
+}
+
+static inline void lock_mcs_acquire(Lock *l) {
+    McsNode *n = lock_mcs_push_node();
+    McsNode *pred = atomic_exchange_explicit(&l->tail, n, memory_order_acq_rel);
+    if (pred == NULL) return;
+    atomic_store_explicit(&pred->next, n, memory_order_release);
+    unsigned spins = 0;
+    while (atomic_load_explicit(&n->waiting, memory_order_acquire)) lock_spin(&spins);
+}
+
+static inline void lock_mcs_release(Lock *l) {
+    McsNode *n = &lock_mcs_nodes[--lock_mcs_depth];
+    McsNode *succ = atomic_load_explicit(&n->next, memory_order_acquire);
+    if (succ == NULL) {
+        McsNode *expected = n;
+        if (atomic_compare_exchange_strong_explicit(&l->tail, &expected, NULL, memory_order_release,
+                                                    memory_order_relaxed)) return;
+        unsigned spins = 0;                              // Sucessor entrou na fila e ainda vai se ligar
+        while ((succ = atomic_load_explicit(&n->next, memory_order_acquire)) == NULL) lock_spin(&spins);
+    }
+    atomic_store_explicit(&succ->waiting, 0, memory_order_release);
+}
+
+// Mutex de três estados (0 livre, 1 ocupada, 2 ocupada com alguém dormindo)
+static inline void lock_futex_acquire(Lock *l) {
+    int c = 0;
+    if (atomic_compare_exchange_strong_explicit(&l->busy, &c, 1, memory_order_acquire, memory_order_relaxed)) return;
+    for (int i = 0; i < TRAVA_FUTEX_GIROS; i++) {
+        lock_pause();
+        c = 0;
+        if (atomic_load_explicit(&l->busy, memory_order_relaxed) == 0 &&
+            atomic_compare_exchange_strong_explicit(&l->busy, &c, 1, memory_order_acquire, memory_order_relaxed)) return;
+    }
+    c = atomic_exchange_explicit(&l->busy, 2, memory_order_acquire);
+    while (c != 0) {
+        lock_futex(&l->busy, FUTEX_WAIT_PRIVATE, 2);
+        c = atomic_exchange_explicit(&l->busy, 2, memory_order_acquire);
+    }
+}
+
+static inline void lock_futex_release(Lock *l) {
+    if (atomic_fetch_sub_explicit(&l->busy, 1, memory_order_release) != 1) {
+        atomic_store_explicit(&l->busy, 0, memory_order_release);
+        lock_futex(&l->busy, FUTEX_WAKE_PRIVATE, 1);
+    }
+}
+
+// ---------------------------------------------------------------------------
+// Interface
+// ---------------------------------------------------------------------------
+static inline void lock_acquire(Lock *l) {
+    switch (l->type) {
+    case LOCK_OMP: omp_set_lock(&l->omp); break;
+    case LOCK_TTAS: lock_ttas_acquire(l); break;
+    case LOCK_TICKET: lock_ticket_acquire(l); break;
+    case LOCK_MCS: lock_mcs_acquire(l); break;
+    default: lock_futex_acquire(l); break;
+    }
+}
+
+// Tenta sem esperar; devolve 1 se adquiriu
+static inline int lock_try(Lock *l) {
+    switch (l->type) {
+    case LOCK_OMP: return omp_test_lock(&l->omp);
+    case LOCK_TTAS:
+        return atomic_load_explicit(&l->busy, memory_order_relaxed) == 0 &&
+               atomic_exchange_explicit(&l->busy, 1, memory_order_acquire) == 0;
+    case LOCK_TICKET: {
+        unsigned serving = atomic_load_explicit(&l->ticket.now_serving, memory_order_relaxed);
+        return atomic_compare_exchange_strong_explicit(&l->ticket.next_ticket, &serving, serving + 1,
+                                                       memory_order_acquire, memory_order_relaxed);
+    }
+    case LOCK_MCS: {
+        McsNode *n = lock_mcs_push_node(), *expected = NULL;
+        if (atomic_compare_exchange_strong_explicit(&l->tail, &expected, n, memory_order_acquire,
+                                                    memory_order_relaxed)) return 1;
+        lock_mcs_depth--;
+        return 0;
+    }
+    default: {
+        int c = 0;
+        return atomic_compare_exchange_strong_explicit(&l->busy, &c, 1, memory_order_acquire, memory_order_relaxed);
+    }
+    }
+}
+
+static inline void lock_release(Lock *l) {
+    switch (l->type) {
+    case LOCK_OMP: omp_unset_lock(&l->omp); break;
+    case LOCK_TTAS: atomic_store_explicit(&l->busy, 0, memory_order_release); break;
+    case LOCK_TICKET:
+        atomic_store_explicit(&l->ticket.now_serving,
+                              atomic_load_explicit(&l->ticket.now_serving, memory_order_relaxed) + 1,
+                              memory_order_release);
+        break;
+    case LOCK_MCS: lock_mcs_release(l); break;
+    default: lock_futex_release(l); break;
+    }
+}
+
+#endif // TRAVAS_H
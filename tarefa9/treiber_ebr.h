@@ -0,0 +1,218 @@
+#ifndef TREIBER_EBR_H
+#define TREIBER_EBR_H
+
+// Pilha de Treiber (inserção e remoção na cabeça com CAS) e recuperação de memória por épocas
+//
+// - push: o novo nó aponta para a cabeça atual e um CAS o publica; não precisa de época
+// - pop e percurso: dentro de uma seção de época (ebr_enter/ebr_exit). Um nó removido não é
+//   liberado na hora: vai para a sacola da thread (ebr_retire), marcada com a época local de
+//   quem retirou, e só é liberado quando a época global está três à frente dessa marca, ou seja,
+//   quando nenhuma thread pode mais estar lendo o nó. Três e não duas: a época global pode já
+//   estar uma à frente da local de quem retira, e um leitor que entrou nessa época seguinte só
+//   segura o avanço da outra depois dela
+// - Como nenhum nó é reaproveitado enquanto alguém pode vê-lo, o CAS do pop não sofre ABA
+// - A época global avança quando todas as threads ativas já viram a época atual; cada thread
+//   tenta avançar a cada EBR_LIMIAR remoções
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdatomic.h>
+
+#define EBR_MAX_THREADS 256
+#define EBR_LIMIAR 64
+#define EBR_LINHA 128
+#define EBR_DISTANCIA 3                      // Épocas entre a retirada (época local) e a liberação
+
+typedef struct {
+    _Alignas(EBR_LINHA) atomic_uint local;   // Época vista ao entrar na seção
+    atomic_int active;
+    void **bag[3];                           // Sacolas de nós retirados, uma por época local módulo 3
+    size_t bag_size[3];
+    size_t bag_capacity[3];
+    unsigned bag_epoch[3];
+    unsigned long retired;
+    unsigned long freed;
+} EbrThread;
+
+typedef struct {
+    _Alignas(EBR_LINHA) atomic_uint global;
+    atomic_int num_threads;
+    EbrThread *threads;
+    void (*free_fn)(void *);
+} Ebr;
+
+static atomic_int ebr_next_id = 0;
+static __thread int ebr_id = -1;
+
+static inline void ebr_init(Ebr *d, void (*free_fn)(void *)) {
+    atomic_init(&d->global, 0);
+    atomic_init(&d->num_threads, 0);
+    d->free_fn = free_fn;
+    if (posix_memalign((void **)&d->threads, EBR_LINHA, EBR_MAX_THREADS * sizeof(EbrThread)) != 0) {
+        fprintf(stderr, "Erro ao alocar memória para as épocas\n");
+        exit(1);
+    }
+    for (int i = 0; i < EBR_MAX_THREADS; i++) {
+        EbrThread *t = &d->threads[i];
+        atomic_init(&t->local, 0);
+        atomic_init(&t->active, 0);
+        for (int b = 0; b < 3; b++) {
+            t->bag[b] = NULL;
+            t->bag_size[b] = t->bag_capacity[b] = 0;
+            t->bag_epoch[b] = 0;
+        }
+        t->retired = t->freed = 0;
+    }
+}
+
+// Índice da thread (atribuído na primeira chamada)
+static inline EbrThread *ebr_thread(Ebr *d) {
+    if (ebr_id < 0) {
+        ebr_id = atomic_fetch_add(&ebr_next_id, 1);
+        if (ebr_id >= EBR_MAX_THREADS) {
+            fprintf(stderr, "Épocas: mais de %d threads\n", EBR_MAX_THREADS);
+            exit(1);
+        }
+    }
+    int n = atomic_load_explicit(&d->num_threads, memory_order_relaxed);
+    while (n <= ebr_id && !atomic_compare_exchange_weak(&d->num_threads, &n, ebr_id + 1)) {}
+    return &d->threads[ebr_id];
+}
+
+static inline void ebr_free_bag(Ebr *d, EbrThread *t, int b) {
+    for (size_t i = 0; i < t->bag_size[b]; i++) d->free_fn(t->bag[b][i]);
+    t->freed += t->bag_size[b];
+    t->bag_size[b] = 0;
+}
+
+// Entra na seção: a partir daqui, nós lidos da estrutura não são liberados até ebr_exit
+static inline EbrThread *ebr_enter(Ebr *d) {
+    EbrThread *t = ebr_thread(d);
+    atomic_store_explicit(&t->active, 1, memory_order_relaxed);
+    unsigned g = atomic_load_explicit(&d->global, memory_order_relaxed);
+    atomic_store_explicit(&t->local, g, memory_order_relaxed);
+    atomic_thread_fence(memory_order_seq_cst);    // Anuncia a época antes de ler ponteiros
+    for (int b = 0; b < 3; b++) {                 // Retirados há EBR_DISTANCIA épocas ou mais: livres
+        if (t->bag_size[b] > 0 && g - t->bag_epoch[b] >= EBR_DISTANCIA) ebr_free_bag(d, t, b);
+    }
+    return t;
+}
+
+static inline void ebr_exit(EbrThread *t) {
+    atomic_store_explicit(&t->active, 0, memory_order_release);
+}
+
+static inline void ebr_try_advance(Ebr *d) {
+    // Par do fence de ebr_enter: ou quem entra vê o nó já desligado, ou esta varredura vê a
+    // thread ativa com a época que ela anunciou
+    atomic_thread_fence(memory_order_seq_cst);
+    unsigned g = atomic_load_explicit(&d->global, memory_order_acquire);
+    int n = atomic_load_explicit(&d->num_threads, memory_order_acquire);
+    for (int i = 0; i < n; i++) {
+        EbrThread *o = &d->threads[i];
+        if (atomic_load_explicit(&o->active, memory_order_acquire) &&
+            atomic_load_explicit(&o->local, memory_order_acquire) != g) return;   // Alguém ainda na época anterior
+    }
+    atomic_compare_exchange_strong(&d->global, &g, g + 1);
+}
+
+// Retira um nó já desligado da estrutura (chamar dentro da seção)
+static inline void ebr_retire(Ebr *d, EbrThread *t, void *p) {
+    unsigned e = atomic_load_explicit(&t->local, memory_order_relaxed);
+    int b = e % 3;
+    if (t->bag_size[b] > 0 && t->bag_epoch[b] != e) ebr_free_bag(d, t, b);   // Sacola de e - 3: global >= e
+    t->bag_epoch[b] = e;
+    if (t->bag_size[b] == t->bag_capacity[b]) {
+        t->bag_capacity[b] = t->bag_capacity[b] ? 2 * t->bag_capacity[b] : 256;
+        t->bag[b] = realloc(t->bag[b], t->bag_capacity[b] * sizeof(void *));
+        if (t->bag[b] == NULL) {
+            fprintf(stderr, "Erro ao alocar memória para a sacola de retirados\n");
+            exit(1);
+        }
+    }
+    t->bag[b][t->bag_size[b]++] = p;
+    if (++t->retired % EBR_LIMIAR == 0) ebr_try_advance(d);
+}
+
+// Sem threads ativas: libera tudo o que ainda está nas sacolas
+static inline void ebr_destroy(Ebr *d, unsigned long *retired, unsigned long *freed_before) {
+    unsigned long r = 0, f = 0;
+    for (int i = 0; i < EBR_MAX_THREADS; i++) {
+        EbrThread *t = &d->threads[i];
+        r += t->retired;
+        f += t->freed;
+        for (int b = 0; b < 3; b++) {
+            ebr_free_bag(d, t, b);
+            free(t->bag[b]);
+        }
+    }
+    if (retired != NULL) *retired = r;
+    if (freed_before != NULL) *freed_before = f;
+    free(d->threads);
+}
+
+// ---------------------------------------------------------------------------
+// Pilha de Treiber
+// ---------------------------------------------------------------------------
+typedef struct TreiberNode {
+    int data;
+    struct TreiberNode *next;     // Não muda depois de publicado
+} TreiberNode;
+
+typedef struct {
+    _Alignas(EBR_LINHA) _Atomic(TreiberNode *) head;
+    Ebr ebr;
+} TreiberStack;
+
+static inline void treiber_init(TreiberStack *s) {
+    atomic_init(&s->head, NULL);
+    ebr_init(&s->ebr, free);
+}
+
+static inline void treiber_push(TreiberStack *s, TreiberNode *n) {
+    n->next = atomic_load_explicit(&s->head, memory_order_relaxed);
+    while (!atomic_compare_exchange_weak_explicit(&s->head, &n->next, n, memory_order_release,
+                                                  memory_order_relaxed)) {}
+}
+
+// Remove da cabeça; devolve 0 com a pilha vazia
+static inline int treiber_pop(TreiberStack *s, int *data) {
+    EbrThread *t = ebr_enter(&s->ebr);
+    TreiberNode *h = atomic_load_explicit(&s->head, memory_order_acquire);
+    while (h != NULL && !atomic_compare_exchange_weak_explicit(&s->head, &h, h->next, memory_order_acquire,
+                                                               memory_order_acquire)) {}
+    if (h != NULL) {
+        *data = h->data;
+        ebr_retire(&s->ebr, t, h);
+    }
+    ebr_exit(t);
+    return h != NULL;
+}
+
+// Percorre até 'limite' nós (limite < 0: todos) somando os dados; seguro com push/pop concorrentes
+static inline long long treiber_sum(TreiberStack *s, long limite, long *visitados) {
+    EbrThread *t = ebr_enter(&s->ebr);
+    long long soma = 0;
+    long n = 0;
+    for (TreiberNode *c = atomic_load_explicit(&s->head, memory_order_acquire); c != NULL && n != limite;
+         c = c->next, n++) {
+        soma += c->data;
+    }
+    ebr_exit(t);
+    if (visitados != NULL) *visitados = n;
+    return soma;
+}
+
+// Sem threads ativas: libera os nós da pilha e as sacolas
+static inline void treiber_destroy(TreiberStack *s, unsigned long *retired, unsigned long *freed_before) {
+    TreiberNode *c = atomic_load(&s->head);
+    while (c != NULL) {
+        TreiberNode *next = c->next;
+        free(c);
+        c = next;
+    }
+    atomic_store(&s->head, NULL);
+    ebr_destroy(&s->ebr, retired, freed_before);
+}
+
+#endif // TREIBER_EBR_H